@@ -20,6 +20,12 @@ public:
     string prime;
     string curve;
     string commit_type;
+    int msm_threads;
+    int msm_tables;
+    int msm_window;
+    string param_seed;
+    string param_cache;
+    int n_eval_points;
 
     PCOptions(ez::ezOptionParser& opt, int argc, const char** argv): EcdsaOptions(opt, argc, argv)
     {
@@ -105,6 +111,60 @@ public:
                 "-ct",
                 "--commit-type"
         );
+        opt.add(
+                "0", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Number of threads for multi-scalar multiplication (default: number of cores)", // Help description.
+                "-mt", // Flag token.
+                "--msm-threads" // Flag token.
+        );
+        opt.add(
+                "1", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Number of precomputed tables of the public parameters for multi-scalar multiplication (default: 1, i.e., no precomputation)", // Help description.
+                "-mp", // Flag token.
+                "--msm-tables" // Flag token.
+        );
+        opt.add(
+                "0", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Window size in bits for multi-scalar multiplication (default: depending on the number of parameters)", // Help description.
+                "-mw", // Flag token.
+                "--msm-window" // Flag token.
+        );
+        opt.add(
+                "", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Fixed seed for public parameters, which enables caching them (default: agree on random seed)", // Help description.
+                "-ps", // Flag token.
+                "--param-seed" // Flag token.
+        );
+        opt.add(
+                "Player-Data", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Directory for cached public parameters (default: Player-Data)", // Help description.
+                "-pd", // Flag token.
+                "--param-cache" // Flag token.
+        );
+        opt.add(
+                "0", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Number of random points for batched evaluation proofs of all committed polynomials (default: 0)", // Help description.
+                "-ep", // Flag token.
+                "--eval-points" // Flag token.
+        );
 
 
         opt.parse(argc, argv);
@@ -128,6 +188,12 @@ public:
         opt.get("--prime")->getString(prime);
         opt.get("-cu")->getString(curve);
         opt.get("-ct")->getString(commit_type);
+        opt.get("-mt")->getInt(msm_threads);
+        opt.get("-mp")->getInt(msm_tables);
+        opt.get("-mw")->getInt(msm_window);
+        opt.get("-ps")->getString(param_seed);
+        opt.get("-pd")->getString(param_cache);
+        opt.get("-ep")->getInt(n_eval_points);
 
         std::cout << "n_model " << n_model << std::endl;
         std::cout << "n_x " << n_x << std::endl;
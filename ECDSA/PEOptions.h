@@ -12,6 +12,7 @@ class PEOptions
 {
 public:
     int n_shares;
+    vector<int> poly_sizes;
     int start;
     int input_party_i;
     string eval_point;
@@ -46,6 +47,15 @@ public:
                 "-i", // Flag token.
                 "--input_party_i" // Flag token.
         );
+        opt.add(
+                "", // Default.
+                0, // Required?
+                -1, // Number of args expected.
+                ',', // Delimiter if expecting multiple args.
+                "Sizes of consecutive polynomials to evaluate in one batch (default: one polynomial of size n_shares)", // Help description.
+                "-ns", // Flag token.
+                "--poly-sizes" // Flag token.
+        );
         opt.add(
                 "",
                 0,
@@ -68,6 +78,10 @@ public:
         opt.parse(argc, argv);
 
         opt.get("-n")->getInt(n_shares);
+        if (opt.isSet("-ns"))
+            opt.get("-ns")->getInts(poly_sizes);
+        else
+            poly_sizes = {n_shares};
         opt.get("-s")->getInt(start);
         opt.get("-i")->getInt(input_party_i);
 
@@ -0,0 +1,161 @@
+/*
+ * PointVector.h
+ *
+ */
+
+#ifndef ECDSA_POINTVECTOR_H_
+#define ECDSA_POINTVECTOR_H_
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <vector>
+#include <string>
+#include <assert.h>
+using namespace std;
+
+/*
+ * Read-only vector of group elements that either owns its content
+ * or refers to a memory-mapped file without copying.
+ */
+template<class T>
+class PointVector
+{
+    vector<T> owned;
+    boost::iostreams::mapped_file_source file;
+    size_t offset;
+
+    const T* data_;
+    size_t size_;
+
+    void update()
+    {
+        if (file.is_open())
+            data_ = (const T*) (file.data() + offset);
+        else
+        {
+            data_ = owned.data();
+            size_ = owned.size();
+        }
+    }
+
+public:
+    PointVector() :
+            offset(0), data_(0), size_(0)
+    {
+    }
+
+    PointVector(vector<T>&& content) :
+            owned(std::move(content)), offset(0)
+    {
+        update();
+    }
+
+    PointVector(const PointVector& other) :
+            owned(other.owned), file(other.file), offset(other.offset),
+            size_(other.size_)
+    {
+        update();
+    }
+
+    PointVector(PointVector&& other) :
+            owned(std::move(other.owned)), file(std::move(other.file)),
+            offset(other.offset), size_(other.size_)
+    {
+        update();
+        other.clear();
+    }
+
+    PointVector& operator=(const PointVector& other)
+    {
+        owned = other.owned;
+        file = other.file;
+        offset = other.offset;
+        size_ = other.size_;
+        update();
+        return *this;
+    }
+
+    PointVector& operator=(PointVector&& other)
+    {
+        if (this == &other)
+            return *this;
+        owned = std::move(other.owned);
+        file = std::move(other.file);
+        offset = other.offset;
+        size_ = other.size_;
+        update();
+        other.clear();
+        return *this;
+    }
+
+    void map(const string& path, size_t offset, size_t n)
+    {
+        clear();
+        file.open(path, offset + n * sizeof(T));
+        assert(file.size() >= offset + n * sizeof(T));
+        this->offset = offset;
+        size_ = n;
+        update();
+    }
+
+    void clear()
+    {
+        owned.clear();
+        // fresh handle because copies share the mapping
+        file = {};
+        offset = 0;
+        update();
+    }
+
+    bool is_mapped() const
+    {
+        return file.is_open();
+    }
+
+    void reserve(size_t n)
+    {
+        assert(not is_mapped());
+        owned.reserve(n);
+        update();
+    }
+
+    void resize(size_t n)
+    {
+        assert(not is_mapped());
+        owned.resize(n);
+        update();
+    }
+
+    void push_back(const T& x)
+    {
+        assert(not is_mapped());
+        owned.push_back(x);
+        update();
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    const T& operator[](size_t i) const
+    {
+        return data_[i];
+    }
+
+    const T* begin() const
+    {
+        return data_;
+    }
+
+    const T* end() const
+    {
+        return data_ + size_;
+    }
+};
+
+#endif /* ECDSA_POINTVECTOR_H_ */
@@ -18,11 +18,14 @@ public:
     int output_start;
     int n_threads;
     int chunk_size;
+    int edabit_batch_size;
+    int max_memory;
     int input_prime_length;
     bool debug;
     bool test;
     bool only_distribute_inputs;
     bool use_share_split;
+    bool stream;
     std::string curve;
 
     SwitchOptions(ez::ezOptionParser& opt, int argc, const char** argv)
@@ -86,7 +89,7 @@ public:
                 0,
                 1,
                 0,
-                "Number of parallel threads",
+                "Maximum number of parallel threads (0 for number of cores)",
                 "-t",
                 "--n_threads"
                 );
@@ -95,10 +98,28 @@ public:
                 0,
                 1,
                 0,
-                "Chunk size",
+                "Maximum chunk size",
                 "-c",
                 "--chunk_size"
                 );
+        opt.add(
+                "0",
+                0,
+                1,
+                0,
+                "Maximum edaBit batch size (default: chunk size)",
+                "-eb",
+                "--edabit_batch"
+                );
+        opt.add(
+                "0",
+                0,
+                1,
+                0,
+                "Memory budget in MB (default: half of available memory)",
+                "-m",
+                "--max_memory"
+                );
         opt.add(
                 "",
                 0,
@@ -144,6 +165,15 @@ public:
                 "-sp",
                 "--split"
         );
+        opt.add(
+                "",
+                0,
+                0,
+                0,
+                "Read, convert and write shares chunk by chunk instead of all at once (requires -n)",
+                "-st",
+                "--stream"
+        );
         opt.add(
                 "bls12377",
                 0,
@@ -164,12 +194,15 @@ public:
         opt.get("-o")->getInt(output_start);
         opt.get("-t")->getInt(n_threads);
         opt.get("-c")->getInt(chunk_size);
+        opt.get("-eb")->getInt(edabit_batch_size);
+        opt.get("-m")->getInt(max_memory);
         opt.get("-pr")->getInt(input_prime_length);
         opt.get("-cu")->getString(curve);
         debug = opt.isSet("-d");
         test = opt.isSet("-te");
         only_distribute_inputs = opt.isSet("-nc");
         use_share_split = opt.isSet("-sp");
+        stream = opt.isSet("-st");
 
         opt.resetArgs();
     }
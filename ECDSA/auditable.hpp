@@ -11,6 +11,7 @@
 #include "Tools/Bundle.h"
 
 #include "poly_commit.hpp"
+#include "param_cache.hpp"
 #include "Math/gfp.hpp"
 #include "Processor/Binary_File_IO.h"
 #include "PCOptions.h"
@@ -18,81 +19,89 @@
 
 //#include "sign.hpp"
 
-template<class Curve>
-Curve random_elem(PRNG& G) {
-    typename Curve::Scalar r_scalar;
-    r_scalar.randomize(G);
-    return Curve(r_scalar);
-}
-
-template<class Curve>
-inline ECPublicParameters<Curve> get_public_parameters(int n_parameters, PRNG& G) {
-    // TODO: Is this consistent across parties?
-    // It seems if we call GlobalPRNG is becomes consistent globally across parties, but it is not always called
-    // so we call it again in the auditable inference function
-
-    ECPublicParameters<Curve> params;
-    for (int i = 0; i < n_parameters; i++) {
-        params.powers_of_g.push_back(random_elem<Curve>(G));
-    }
-
-    params.g2 = random_elem<Curve>(G);
-    return params;
-}
-
-
 template<template<class U> class T, class Curve, template<class> class Commitment>
 std::string generate_vector_commitments(
         typename T<Curve>::MAC_Check& MCc,
         Player& P,
-        PCOptions& opts)
+        PCOptions& opts,
+        typename T<typename Curve::Scalar>::MAC_Check* MCp = 0)
 {
-    SeededPRNG G;
-    G.SeedGlobally(P);
-
 //    test_arith();
     std::vector<Commitment<Curve>> commitments;
 
     int commitment_sizes_arr[] = { opts.n_model, opts.n_x, opts.n_y };
     std::vector<int> commitment_sizes(commitment_sizes_arr, commitment_sizes_arr + 3);
     int n_parameters = max_element(commitment_sizes.begin(), commitment_sizes.end()).operator*();
-    ECPublicParameters publicParameters = get_public_parameters<Curve>(n_parameters, G);
+    ECPublicParameters publicParameters = get_public_parameters<Curve>(n_parameters, P, opts);
+    publicParameters.init_msm(opts.msm_threads, opts.msm_tables, opts.msm_window);
+    publicParameters.get_msm_engine().precompute(n_parameters);
 
     Timer timer;
     timer.start();
     auto stats = P.total_comm();
 
-    std::vector<T<Curve>> commitment_shares;
     int start = opts.start;
     typedef T<typename Curve::Scalar> inputShare;
+    std::vector<InputPolynomial<inputShare>> polynomials;
     for (int size : commitment_sizes) {
         // Proof for each size poly commitment
         if (size == 0) {
             continue;
         }
         std::cout << "Committing to polynomial of size " << size << endl;
-        std::vector< inputShare > input = read_inputs<inputShare >(P, size, start, KZG_SUFFIX);
-
         InputPolynomial<inputShare> polynomial;
-        for (int i = 0; i < size; i++)
-        {
-            polynomial.coeffs.push_back(input[i]);
-        }
+        polynomial.coeffs = read_inputs<inputShare >(P, size, start, KZG_SUFFIX);
 
         assert(polynomial.coeffs.size() <= publicParameters.powers_of_g.size());
 
-        commitment_shares.push_back(commit_and_open<T, Curve>(polynomial, publicParameters));
+        polynomials.push_back(std::move(polynomial));
         start = start + size;
     }
 
+    // all MSMs in one pass over the parameters
+    std::vector<T<Curve>> commitment_shares = commit_batch<T, Curve>(polynomials, publicParameters);
+
+    // evaluation proofs at public random points
+    KZGBatchProof<inputShare, T<Curve>> proof;
+    vector<typename Curve::Scalar> points;
+    if (opts.n_eval_points > 0) {
+        assert(MCp);
+        SeededPRNG G;
+        G.SeedGlobally(P);
+        typename Curve::Scalar gamma;
+        gamma.randomize(G);
+        points.resize(opts.n_eval_points);
+        for (auto& point : points)
+            point.randomize(G);
+        proof = kzg_batch_prove<T, Curve>(polynomials, points, gamma, publicParameters);
+    }
+
+    // open commitments and witnesses in one round
+    std::vector<T<Curve>> curve_shares = commitment_shares;
+    curve_shares.insert(curve_shares.end(), proof.witnesses.begin(), proof.witnesses.end());
     vector<Curve> commitment_elements;
-    MCc.POpen_Begin(commitment_elements, commitment_shares, P);
-    MCc.POpen_End(commitment_elements, commitment_shares, P);
+    MCc.POpen_Begin(commitment_elements, curve_shares, P);
+    MCc.POpen_End(commitment_elements, curve_shares, P);
 
     // We do this once for all the commitments, because of the protocol
     MCc.Check(P);
 
-    for (int i = 0; i < (int)commitment_elements.size(); i++) {
+    if (opts.n_eval_points > 0) {
+        vector<inputShare> value_shares;
+        for (auto& values : proof.values)
+            value_shares.insert(value_shares.end(), values.begin(), values.end());
+        vector<typename Curve::Scalar> values;
+        MCp->POpen(values, value_shares, P);
+        MCp->Check(P);
+        for (size_t j = 0; j < points.size(); j++) {
+            cout << "evaluation_point_" << j << "=" << points[j] << endl;
+            for (size_t i = 0; i < polynomials.size(); i++)
+                cout << "evaluation_" << j << "_" << i << "=" << values[j * polynomials.size() + i] << endl;
+            cout << "evaluation_witness_" << j << "=" << commitment_elements[commitment_shares.size() + j] << endl;
+        }
+    }
+
+    for (int i = 0; i < (int)commitment_shares.size(); i++) {
         commitments.push_back(Commitment<Curve> { commitment_elements[i] });
     }
 
@@ -124,14 +133,11 @@ std::string generate_individual_commitments(
         Player& P,
         PCOptions& opts)
 {
-    SeededPRNG G;
-    G.SeedGlobally(P);
-
 //    test_arith();
     int commitment_sizes_arr[] = { opts.n_model, opts.n_x, opts.n_y };
     std::vector<int> commitment_sizes(commitment_sizes_arr, commitment_sizes_arr + 3);
     int n_parameters = max_element(commitment_sizes.begin(), commitment_sizes.end()).operator*();
-    ECPublicParameters publicParameters = get_public_parameters<Curve>(n_parameters, G);
+    ECPublicParameters publicParameters = get_public_parameters<Curve>(n_parameters, P, opts);
 
     Timer timer;
     timer.start();
@@ -42,6 +42,7 @@
 #include "Machines/Rep.hpp"
 #include "ECDSA/share_utils.hpp"
 #include "ECDSA/SwitchOptions.h"
+#include "ECDSA/switch_plan.hpp"
 
 #include "omp.h"
 
@@ -851,6 +852,7 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
     ez::ezOptionParser opt;
     SwitchOptions opts(opt, argc, argv);
     assert(opts.inputs_format.size() == 0 or opts.n_shares == 0); // can only specify one
+    assert(not opts.stream or (opts.n_shares > 0 and not opts.test)); // streaming reads from the share file
 
     // Set outputShare
 
@@ -918,7 +920,9 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
         outputShare::clear::init_field(output_field_prime);
         outputShare::clear::next::init_field(output_field_prime, false);
 
-        input_shares = read_inputs<inputShare>(P, opts.n_shares, opts.start);
+        // otherwise every thread reads its chunks when needed
+        if (not opts.stream)
+            input_shares = read_inputs<inputShare>(P, opts.n_shares, opts.start);
         log_name = "share_switch_output";
     } else if (opts.inputs_format.size() > 0) {
 
@@ -967,47 +971,17 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
     timer.start();
     auto stats = P.total_comm();
 
-    vector<outputShare> result(input_shares.size());
+    const unsigned long n_total = opts.stream ? opts.n_shares : input_shares.size();
+    vector<outputShare> result(opts.stream ? 0 : n_total);
 
-//    vector<CryptoPlayer> players;
-//    for (int i = 0; i < n_chunks; i++) {
-//        players.push_back(CryptoPlayer(N, i * 3));
-//    }
+    const SwitchPlan plan = SwitchPlan::make<inputShare, outputShare>(P, n_total, n_bits_per_input, opts);
+    plan.print();
 
-    const bool has_large_edabit_batch_size = inputShare::malicious;
-    // It seems that the large batch size is dynamic...  for now just assume its ~10k
-    unsigned long min_batch_size_per_thread = 1;
-    if (has_large_edabit_batch_size) {
-        min_batch_size_per_thread = 10000;
-    }
+    const int n_threads = plan.n_threads;
+    const unsigned long n_samples_per_thread = DIV_CEIL(n_total, n_threads);
+    const unsigned long mem_cutoff = plan.chunk_size;
 
-    int n_threads = opts.n_threads;
-    if (n_threads > 1) {
-        if (input_shares.size() < 10000 && n_threads > 18) {
-            n_threads = 18;
-            std::cout << "Using 18 threads because only " << input_shares.size() << " shares" << endl;
-        }
-        if (input_shares.size() < 1000) {
-            n_threads = 1;
-            std::cout << "Using single thread because only " << input_shares.size() << " shares" << endl;
-        }
-        const unsigned long n_samples_per_thread = DIV_CEIL(input_shares.size(), n_threads);
-        if (n_samples_per_thread < min_batch_size_per_thread) {
-            n_threads = DIV_CEIL(input_shares.size(), min_batch_size_per_thread);
-            std::cout << "Using " << n_threads << " threads because only " << input_shares.size() << " shares" << endl;
-        }
-    }
-
-    const unsigned long n_samples_per_thread = DIV_CEIL(input_shares.size(), n_threads);
-    const unsigned long mem_cutoff = opts.chunk_size;
-
-//    if ((opts.n_threads - 1) * n_chunks_per_thread > input_shares.size()) {
-//        std::cout << "Warning: not enough shares to distribute to all threads" << endl;
-//        std::cout << "Setting number of threads to "
-//    }
-
-    std::cout << "Edabit batch size " << OnlineOptions::singleton.batch_size << ". Would have needed " << min(n_samples_per_thread, mem_cutoff) << endl;
-    OnlineOptions::singleton.batch_size = min((unsigned long)150000, min(n_samples_per_thread, mem_cutoff));
+    OnlineOptions::singleton.batch_size = plan.edabit_batch_size;
     OnlineOptions::singleton.verbose = true;
 
     const bigint shift_in = bigint(1) << (n_bits_per_input - 1);
@@ -1021,8 +995,6 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
 
     //    std::cout << "shift_out_t initially " << shift_out_t << " " << n_bits_per_input << " " << outputShare::clear::n_bits() << endl;
 
-    std::cout << "Running in " << n_threads << " threads" << endl;
-
     std::vector<NamedCommStats> thread_local_diffs(n_threads);
 
     // If we reach until here, we cannot have the same input as output because of networking,
@@ -1030,12 +1002,17 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
     auto has_same_types = is_same<inputShare, outputShare>::value;
     assert(not has_same_types);
 
+    bool overwrite = opts.output_start == 0;
+    if (opts.stream) {
+        prepare_share_file<outputShare>(P, n_total, KZG_SUFFIX, overwrite, opts.output_start);
+    }
+
 #pragma omp parallel for num_threads(n_threads)
     for (int j = 0; j < n_threads; j++) {
         bigint::init_thread();
 
         const unsigned long begin_thread = j * n_samples_per_thread;
-        const unsigned long end_thread = min(((unsigned long) (j + 1) * n_samples_per_thread), input_shares.size());
+        const unsigned long end_thread = min(((unsigned long) (j + 1) * n_samples_per_thread), n_total);
         if (begin_thread >= end_thread) {
             stringstream stream;
             stream << "Thread " << j << "(" << omp_get_thread_num() << ") will skip processing because not enough shares" << std::endl;
@@ -1064,10 +1041,21 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
             const unsigned long end_chunk = min(begin_chunk + mem_cutoff, end_thread);
             // each thread in parallel
 
+            vector<inputShare> chunk_shares;
+            typename vector<inputShare>::iterator chunk_begin, chunk_end;
+            if (opts.stream) {
+                chunk_shares = read_inputs<inputShare>(P_j, end_chunk - begin_chunk, opts.start + begin_chunk);
+                chunk_begin = chunk_shares.begin();
+                chunk_end = chunk_shares.end();
+            } else {
+                chunk_begin = input_shares.begin() + begin_chunk;
+                chunk_end = input_shares.begin() + end_chunk;
+            }
+
             vector<outputShare> res;
             if (input_is_field) {
-                res = convert_shares_field(input_shares.begin() + begin_chunk,
-                                           input_shares.begin() + end_chunk,
+                res = convert_shares_field(chunk_begin,
+                                           chunk_end,
                                            set_input_i, set_output_i, setup_input_i.get_mac_key(),
                                            setup_input_i.binary.get_mac_key(),
                                            setup_output_i.get_mac_key(), P_j, n_bits_per_input,
@@ -1075,16 +1063,16 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
                                            opts.debug);
             } else if (inputShare::has_split && opts.use_share_split) {
                 std::cout << "Using share splitting";
-                res = convert_shares_ring_split(input_shares.begin() + begin_chunk,
-                                          input_shares.begin() + end_chunk,
+                res = convert_shares_ring_split(chunk_begin,
+                                          chunk_end,
                                           set_input_i, set_output_i, setup_input_i.get_mac_key(),
                                           setup_input_i.binary.get_mac_key(),
                                           setup_output_i.get_mac_key(), P_j, n_bits_per_input,
                                           shift_int_t, shift_out_t,
                                           opts.debug);
             } else {
-                res = convert_shares_ring(input_shares.begin() + begin_chunk,
-                                                               input_shares.begin() + end_chunk,
+                res = convert_shares_ring(chunk_begin,
+                                                               chunk_end,
                                                                set_input_i, set_output_i, setup_input_i.get_mac_key(),
                                                                setup_input_i.binary.get_mac_key(),
                                                                setup_output_i.get_mac_key(), P_j, n_bits_per_input,
@@ -1093,8 +1081,12 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
             }
 
 //            result.insert(result.begin() + begin_chunk, res.begin(), res.end());
-            for (unsigned long k = 0; k < res.size(); k++) {
-                result[begin_chunk + k] = res[k];
+            if (opts.stream) {
+                write_share_range<outputShare>(P_j, res, opts.output_start + begin_chunk, KZG_SUFFIX);
+            } else {
+                for (unsigned long k = 0; k < res.size(); k++) {
+                    result[begin_chunk + k] = res[k];
+                }
             }
 
             stringstream stream2;
@@ -1113,10 +1105,10 @@ void run(int argc, const char** argv, bigint output_field_prime, int bit_length
 //    set_output.check();
 
 
-    std::cout << "Share 0 " << result[0] << std::endl;
-
-    bool overwrite = opts.output_start == 0;
-    write_shares<outputShare>(P, result, KZG_SUFFIX, overwrite, opts.output_start);
+    if (not opts.stream) {
+        std::cout << "Share 0 " << result[0] << std::endl;
+        write_shares<outputShare>(P, result, KZG_SUFFIX, overwrite, opts.output_start);
+    }
 
     auto diff = P.total_comm() - stats;
 
@@ -40,19 +40,27 @@ void ecscalarmulshare(Curve point, SpdzWiseShare<T<typename Curve::Scalar> > mul
 }
 
 template<class Curve>
-SpdzWiseShare<MaliciousRep3Share<Curve>> msm(std::vector<Curve>& bases, std::vector<SpdzWiseShare<MaliciousRep3Share<typename Curve::Scalar>>> & multipliers){
-
-    std::vector<MaliciousRep3Share<typename Curve::Scalar> > multiplier_shares(multipliers.size());
-    std::vector<MaliciousRep3Share<typename Curve::Scalar> > multiplier_macs(multipliers.size());
-    for (unsigned long i = 0; i < multipliers.size(); i++) {
-        multiplier_shares[i] = multipliers[i].get_share();
-        multiplier_macs[i] = multipliers[i].get_mac();
+std::vector<SpdzWiseShare<MaliciousRep3Share<Curve>>> batch_msm(MSMEngine<Curve>& engine, const std::vector<const std::vector<SpdzWiseShare<MaliciousRep3Share<typename Curve::Scalar>>>*> & multipliers){
+    // share and MAC in the same pass
+    auto sums = engine.run(msm_lengths(multipliers), 4,
+            [&](size_t j, size_t i, int k) -> const typename Curve::Scalar& {
+                auto& x = (*multipliers[j])[i];
+                if (k < 2)
+                    return x.get_share()[k];
+                else
+                    return x.get_mac()[k - 2];
+            });
+
+    std::vector<SpdzWiseShare<MaliciousRep3Share<Curve>>> res;
+    for (size_t j = 0; j < multipliers.size(); j++) {
+        MaliciousRep3Share<Curve> result_share, result_mac;
+        for (int k = 0; k < 2; k++) {
+            result_share[k] = sums[4 * j + k];
+            result_mac[k] = sums[4 * j + k + 2];
+        }
+        res.push_back(SpdzWiseShare<MaliciousRep3Share<Curve>>(result_share, result_mac));
     }
-
-    MaliciousRep3Share<Curve> result_share = msm(bases, multiplier_shares);
-    MaliciousRep3Share<Curve> result_mac = msm(bases, multiplier_macs);
-
-    return SpdzWiseShare(result_share, result_mac);
+    return res;
 }
 
 template<class Curve>
@@ -0,0 +1,309 @@
+/*
+ * msm.hpp
+ *
+ * Multi-scalar multiplication with the bucket method (Pippenger)
+ *
+ */
+
+#ifndef ECDSA_MSM_HPP_
+#define ECDSA_MSM_HPP_
+
+#include "Math/gfp.h"
+#include "Tools/time-func.h"
+
+#include <thread>
+#include <omp.h>
+
+/*
+ * Bucket-method MSM over a fixed vector of bases.
+ *
+ * The bases are neither copied nor owned. Optionally, ``n_tables - 1``
+ * additional tables of shifted bases are computed once so that the
+ * windows of a scalar are spread across tables, which divides the number of
+ * doublings per MSM by ``n_tables`` at the cost of that much memory.
+ * All components of a share (e.g., both parts of a replicated share or
+ * share and MAC) are processed in the same pass over the bases.
+ */
+template<class Curve>
+class MSMEngine
+{
+public:
+    typedef typename Curve::Scalar Scalar;
+    static const int N_LIMBS = Scalar::N_LIMBS;
+    typedef array<mp_limb_t, N_LIMBS> limbs_type;
+
+private:
+    const Curve* bases;
+    size_t n_bases;
+    vector<vector<Curve>> tables;
+
+    int n_threads;
+    int window;
+    int n_tables;
+    int n_windows;
+    int windows_per_table;
+
+    size_t n_precomputed;
+
+    static int default_window(size_t n)
+    {
+        if (n < 32)
+            return 3;
+        // roughly ln(n) + 2
+        int log = 0;
+        while ((size_t(1) << log) < n)
+            log++;
+        return min(16, log * 69 / 100 + 2);
+    }
+
+    static void to_limbs(limbs_type& res, const Scalar& x)
+    {
+        // multiplication by raw one removes Montgomery representation if any
+        static thread_local modp_<N_LIMBS> raw_one;
+        static thread_local bool initialized = false;
+        if (not initialized)
+        {
+            mp_limb_t one[N_LIMBS] = {1};
+            raw_one.assign(one, Scalar::get_ZpD().get_t());
+            initialized = true;
+        }
+        modp_<N_LIMBS> tmp;
+        Mul(tmp, x.get(), raw_one, Scalar::get_ZpD());
+        for (int i = 0; i < N_LIMBS; i++)
+            res[i] = tmp.get_limb(i);
+    }
+
+    int digit(const limbs_type& x, int j) const
+    {
+        int start = j * window;
+        int limb = start / 64, offset = start % 64;
+        if (limb >= N_LIMBS)
+            return 0;
+        mp_limb_t res = x[limb] >> offset;
+        if (offset + window > 64 and limb + 1 < N_LIMBS)
+            res |= x[limb + 1] << (64 - offset);
+        return res & ((mp_limb_t(1) << window) - 1);
+    }
+
+    const Curve& table_entry(int k, size_t i) const
+    {
+        if (k == 0)
+            return bases[i];
+        else
+            return tables[k - 1][i];
+    }
+
+    template<class V>
+    vector<Curve> run_range(size_t begin, size_t end,
+            const vector<size_t>& lengths, int n_components,
+            const V& get_component) const;
+
+public:
+    static int get_n_threads(int requested)
+    {
+        if (requested > 0)
+            return requested;
+        return max(1u, thread::hardware_concurrency());
+    }
+
+    MSMEngine(const Curve* bases, size_t n_bases, int n_threads = 0,
+            int n_tables = 1, int window = 0) :
+            bases(bases), n_bases(n_bases),
+            n_threads(get_n_threads(n_threads)), window(window),
+            n_tables(max(1, n_tables)), n_precomputed(0)
+    {
+        if (this->window <= 0)
+            this->window = default_window(n_bases);
+        n_windows = DIV_CEIL(Scalar::length(), this->window);
+        this->n_tables = min(this->n_tables, n_windows);
+        windows_per_table = DIV_CEIL(n_windows, this->n_tables);
+    }
+
+    size_t size() const
+    {
+        return n_bases;
+    }
+
+    // compute shifted tables for the first n bases
+    void precompute(size_t n);
+
+    /*
+     * Compute sum_i get_component(i, k) * bases[i] for every component k
+     * and i in [0, n).
+     */
+    template<class V>
+    vector<Curve> run(size_t n, int n_components, const V& get_component);
+
+    /*
+     * Batch of several vectors of scalars with different lengths
+     * in one pass over the bases. The result contains
+     * sum_i get_component(j, i, k) * bases[i] for i in [0, lengths[j])
+     * at position j * n_components + k.
+     */
+    template<class V>
+    vector<Curve> run(const vector<size_t>& lengths, int n_components,
+            const V& get_component);
+};
+
+template<class Curve>
+void MSMEngine<Curve>::precompute(size_t n)
+{
+    assert(n <= n_bases);
+    if (n_tables < 2 or n <= n_precomputed)
+        return;
+
+    Timer timer;
+    timer.start();
+    int shift = windows_per_table * window;
+    tables.resize(n_tables - 1);
+    for (auto& table : tables)
+        table.resize(n);
+
+#pragma omp parallel for num_threads(n_threads)
+    for (size_t i = n_precomputed; i < n; i++)
+    {
+        Curve x = bases[i];
+        for (int k = 0; k < n_tables - 1; k++)
+        {
+            for (int j = 0; j < shift; j++)
+                x = x.dbl();
+            tables[k][i] = x;
+        }
+    }
+
+    n_precomputed = n;
+    cout << "MSM precomputation of " << n_tables << " tables for " << n
+            << " bases took " << timer.elapsed() * 1e3 << " ms" << endl;
+}
+
+template<class Curve>
+template<class V>
+vector<Curve> MSMEngine<Curve>::run(size_t n, int n_components,
+        const V& get_component)
+{
+    return run(vector<size_t>({n}), n_components,
+            [&](size_t, size_t i, int k) -> const Scalar&
+            { return get_component(i, k); });
+}
+
+template<class Curve>
+template<class V>
+vector<Curve> MSMEngine<Curve>::run(const vector<size_t>& lengths,
+        int n_components, const V& get_component)
+{
+    size_t n = 0, total = 0;
+    for (auto length : lengths)
+    {
+        n = max(n, length);
+        total += length;
+    }
+    assert(n <= n_bases);
+    precompute(n);
+
+    // split bases such that every part covers about the same number of scalars
+    int n_parts = max(1, min(n_threads, int(DIV_CEIL(total, 1 << window))));
+    vector<size_t> bounds(1, 0);
+    size_t work = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        for (auto length : lengths)
+            work += length > i;
+        if (work * n_parts >= bounds.size() * total
+                and bounds.size() < size_t(n_parts))
+            bounds.push_back(i + 1);
+    }
+    bounds.push_back(n);
+    n_parts = bounds.size() - 1;
+
+    size_t n_results = lengths.size() * n_components;
+    vector<vector<Curve>> partial_sums(n_parts);
+
+#pragma omp parallel for num_threads(n_parts)
+    for (int j = 0; j < n_parts; j++)
+    {
+        bigint::init_thread();
+        if (bounds[j] < bounds[j + 1])
+            partial_sums[j] = run_range(bounds[j], bounds[j + 1], lengths,
+                    n_components, get_component);
+        else
+            partial_sums[j].resize(n_results, Curve::zero());
+    }
+
+    vector<Curve> res(n_results, Curve::zero());
+    for (auto& sums : partial_sums)
+        for (size_t k = 0; k < n_results; k++)
+            res[k] += sums[k];
+    return res;
+}
+
+template<class Curve>
+template<class V>
+vector<Curve> MSMEngine<Curve>::run_range(size_t begin, size_t end,
+        const vector<size_t>& lengths, int n_components,
+        const V& get_component) const
+{
+    // one column per polynomial and component
+    size_t n_columns = lengths.size() * n_components;
+    vector<vector<limbs_type>> scalars(n_columns);
+    for (size_t j = 0; j < lengths.size(); j++)
+    {
+        size_t n = max(begin, min(end, lengths[j])) - begin;
+        for (int k = 0; k < n_components; k++)
+        {
+            auto& column = scalars[j * n_components + k];
+            column.resize(n);
+            for (size_t i = 0; i < n; i++)
+                to_limbs(column[i], get_component(j, begin + i, k));
+        }
+    }
+
+    int n_buckets = (1 << window) - 1;
+    vector<Curve> buckets(n_buckets * n_columns);
+    vector<Curve> res(n_columns, Curve::zero());
+
+    for (int r = windows_per_table - 1; r >= 0; r--)
+    {
+        if (r != windows_per_table - 1)
+            for (auto& x : res)
+                for (int j = 0; j < window; j++)
+                    x = x.dbl();
+
+        for (auto& bucket : buckets)
+            bucket = Curve::zero();
+
+        for (int k = 0; k < n_tables; k++)
+        {
+            int w = k * windows_per_table + r;
+            if (w >= n_windows)
+                continue;
+            for (size_t i = 0; i < end - begin; i++)
+            {
+                auto& base = table_entry(k, begin + i);
+                for (size_t l = 0; l < n_columns; l++)
+                {
+                    auto& column = scalars[l];
+                    if (i >= column.size())
+                        continue;
+                    int d = digit(column[i], w);
+                    if (d)
+                        buckets[l * n_buckets + d - 1] += base;
+                }
+            }
+        }
+
+        for (size_t l = 0; l < n_columns; l++)
+        {
+            Curve running = Curve::zero(), sum = Curve::zero();
+            for (int d = n_buckets - 1; d >= 0; d--)
+            {
+                running += buckets[l * n_buckets + d];
+                sum += running;
+            }
+            res[l] += sum;
+        }
+    }
+
+    return res;
+}
+
+#endif /* ECDSA_MSM_HPP_ */
@@ -241,7 +241,7 @@ void run(int argc, const char** argv, bigint order)
 
         typename T<Curve>::Direct_MC inputMCc(inputMCp.get_alphai());
         if (opts.commit_type == "ec_vec") {
-            message = generate_vector_commitments<T, Curve, ECVectorCommitment>(inputMCc, P, opts);
+            message = generate_vector_commitments<T, Curve, ECVectorCommitment>(inputMCc, P, opts, &inputMCp);
         } else if (opts.commit_type == "ec_individual") {
             message = generate_individual_commitments<T, Curve>(inputMCc, set, P, opts);
         }
@@ -0,0 +1,296 @@
+/*
+ * param_cache.hpp
+ *
+ * Deterministic generation and on-disk caching of public parameters
+ *
+ */
+
+#ifndef ECDSA_PARAM_CACHE_HPP_
+#define ECDSA_PARAM_CACHE_HPP_
+
+#include "poly_commit.hpp"
+#include "share_utils.hpp"
+#include "Tools/octetStream.h"
+#include "Tools/Exceptions.h"
+#include "Tools/time-func.h"
+
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+#include <omp.h>
+
+// whether the in-memory representation can be stored and mapped as is
+template<class Curve>
+struct has_fixed_layout : false_type
+{
+};
+
+template<>
+struct has_fixed_layout<P377Element> : true_type
+{
+};
+
+template<class Curve>
+Curve random_elem(PRNG& G) {
+    typename Curve::Scalar r_scalar;
+    r_scalar.randomize(G);
+    return Curve(r_scalar);
+}
+
+/*
+ * Element i only depends on the seed and i, so a shorter set of
+ * parameters can be extended without regenerating it.
+ */
+template<class Curve>
+class ParameterGenerator
+{
+    static const size_t BLOCK_SIZE = 256;
+
+    octetStream seed;
+
+    PRNG block_prng(size_t block) const
+    {
+        octetStream os = seed;
+        os.store(block);
+        octetStream hash = os.hash();
+        return PRNG(hash);
+    }
+
+public:
+    ParameterGenerator(const octet* seed) :
+            seed(SEED_SIZE, seed)
+    {
+    }
+
+    // fill res[i] for i in [begin, end)
+    void generate(Curve* res, size_t begin, size_t end) const
+    {
+        size_t first_block = begin / BLOCK_SIZE;
+        size_t n_blocks = DIV_CEIL(end, BLOCK_SIZE) - first_block;
+#pragma omp parallel for
+        for (size_t j = 0; j < n_blocks; j++)
+        {
+            bigint::init_thread();
+            size_t block = first_block + j;
+            PRNG G = block_prng(block);
+            for (size_t i = block * BLOCK_SIZE;
+                    i < min(end, (block + 1) * BLOCK_SIZE); i++)
+            {
+                // keep the sequence independent of begin
+                Curve x = random_elem<Curve>(G);
+                if (i >= begin)
+                    res[i - begin] = x;
+            }
+        }
+    }
+
+    Curve generate(size_t i) const
+    {
+        Curve res;
+        generate(&res, i, i + 1);
+        return res;
+    }
+
+    Curve g2() const
+    {
+        // outside the range of any power
+        return generate(size_t(1) << 48);
+    }
+};
+
+// consistent across parties only if G is seeded globally
+template<class Curve>
+inline ECPublicParameters<Curve> get_public_parameters(int n_parameters, PRNG& G) {
+    ParameterGenerator<Curve> generator(G.get_seed());
+    ECPublicParameters<Curve> params;
+    vector<Curve> powers(n_parameters);
+    generator.generate(powers.data(), 0, n_parameters);
+    params.powers_of_g = std::move(powers);
+    params.g2 = generator.g2();
+    return params;
+}
+
+/*
+ * Public parameters stored in a file per curve and seed:
+ * fixed-size header followed by the powers, either in memory
+ * representation (mapped without copying) or packed.
+ */
+template<class Curve>
+class ParameterCache
+{
+    static const int VERSION = 1;
+    static const int HEADER_SIZE = 64;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t element_size;
+        uint64_t n_elements;
+        char curve[16];
+        char padding[HEADER_SIZE - 40];
+    };
+
+    static_assert(sizeof(Header) == HEADER_SIZE, "wrong header size");
+
+    string filename;
+    ParameterGenerator<Curve> generator;
+
+    static uint32_t element_size()
+    {
+        return has_fixed_layout<Curve>::value ? sizeof(Curve) : 0;
+    }
+
+    static Header make_header(size_t n_elements)
+    {
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "MPSPDZPP", 8);
+        header.version = VERSION;
+        header.element_size = element_size();
+        header.n_elements = n_elements;
+        strncpy(header.curve, Curve::type_string().c_str(),
+                sizeof(header.curve) - 1);
+        return header;
+    }
+
+    // number of cached powers or 0 if missing or incompatible
+    size_t cached_size() const
+    {
+        ifstream file(filename);
+        Header header;
+        file.read((char*) &header, sizeof(header));
+        if (not file.good())
+            return 0;
+        auto expected = make_header(header.n_elements);
+        if (memcmp(&header, &expected, sizeof(header)))
+        {
+            cerr << "Ignoring incompatible parameter cache " << filename
+                    << endl;
+            return 0;
+        }
+        return header.n_elements;
+    }
+
+    void load(PointVector<Curve>& res, size_t n) const
+    {
+        if (has_fixed_layout<Curve>::value)
+            res.map(filename, HEADER_SIZE, n);
+        else
+        {
+            ifstream file(filename);
+            file.seekg(HEADER_SIZE);
+            octetStream os;
+            os.input(file);
+            vector<Curve> content(n);
+            for (auto& x : content)
+                x = os.get<Curve>();
+            res = std::move(content);
+        }
+    }
+
+    // write via temporary file to allow concurrent readers
+    void store(const PointVector<Curve>& existing,
+            const vector<Curve>& extension) const
+    {
+        string tmp_name = filename + ".tmp" + to_string(getpid());
+        ofstream file(tmp_name);
+        auto header = make_header(existing.size() + extension.size());
+        file.write((char*) &header, sizeof(header));
+        if (has_fixed_layout<Curve>::value)
+        {
+            file.write((char*) existing.data(),
+                    existing.size() * sizeof(Curve));
+            file.write((char*) extension.data(),
+                    extension.size() * sizeof(Curve));
+        }
+        else
+        {
+            octetStream os;
+            for (auto& x : existing)
+                os.store(x);
+            for (auto& x : extension)
+                os.store(x);
+            os.output(file);
+        }
+        file.close();
+        if (file.fail())
+            throw file_error(tmp_name);
+        if (rename(tmp_name.c_str(), filename.c_str()))
+            throw file_error(filename);
+    }
+
+public:
+    static string get_filename(const string& dir, const octet* seed)
+    {
+        stringstream ss;
+        ss << dir << "/Params-" << Curve::type_string() << "-";
+        octetStream hash = octetStream(SEED_SIZE, seed).hash();
+        for (int i = 0; i < 8; i++)
+            ss << hex << setw(2) << setfill('0') << int(hash.get_data()[i]);
+        return ss.str();
+    }
+
+    ParameterCache(const string& dir, const octet* seed) :
+            filename(get_filename(dir, seed)), generator(seed)
+    {
+    }
+
+    ECPublicParameters<Curve> get(size_t n)
+    {
+        Timer timer;
+        timer.start();
+        ECPublicParameters<Curve> params;
+        size_t n_cached = cached_size();
+
+        if (n_cached > 0)
+        {
+            load(params.powers_of_g, min(n, n_cached));
+            // detect layout mismatches
+            if (params.powers_of_g[0] != generator.generate(0))
+            {
+                cerr << "Parameter cache " << filename
+                        << " does not match, regenerating" << endl;
+                params.powers_of_g = {};
+                n_cached = 0;
+            }
+        }
+
+        if (n_cached < n)
+        {
+            vector<Curve> extension(n - n_cached);
+            generator.generate(extension.data(), n_cached, n);
+            store(params.powers_of_g, extension);
+            cout << "Generated " << extension.size()
+                    << " public parameters in addition to " << n_cached
+                    << " cached in " << filename << endl;
+            load(params.powers_of_g, n);
+        }
+
+        params.g2 = generator.g2();
+        print_timer("param_load", timer.elapsed());
+        return params;
+    }
+};
+
+/*
+ * Parameters from a fixed seed are cached, otherwise they are generated
+ * from a seed agreed by all parties.
+ */
+template<class Curve>
+ECPublicParameters<Curve> get_public_parameters(int n_parameters, Player& P,
+        PCOptions& opts)
+{
+    if (opts.param_seed.empty())
+    {
+        SeededPRNG G;
+        G.SeedGlobally(P);
+        return get_public_parameters<Curve>(n_parameters, G);
+    }
+
+    octetStream seed = octetStream(opts.param_seed).hash();
+    return ParameterCache<Curve>(opts.param_cache, seed.get_data()).get(
+            n_parameters);
+}
+
+#endif /* ECDSA_PARAM_CACHE_HPP_ */
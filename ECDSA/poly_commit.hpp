@@ -14,14 +14,46 @@
 #include "Math/gfp.hpp"
 
 #include "PCOptions.h"
-
-#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include "msm.hpp"
+#include "PointVector.h"
 
 template<class Curve>
 class ECPublicParameters {
+    // refers to powers_of_g, hence not copied along
+    unique_ptr<MSMEngine<Curve>> msm_engine;
+
 public:
-    vector<Curve> powers_of_g;
+    PointVector<Curve> powers_of_g;
     Curve g2;
+
+    ECPublicParameters()
+    {
+    }
+
+    ECPublicParameters(const ECPublicParameters& other) :
+            powers_of_g(other.powers_of_g), g2(other.g2)
+    {
+    }
+
+    ECPublicParameters(ECPublicParameters&& other) :
+            powers_of_g(std::move(other.powers_of_g)), g2(other.g2)
+    {
+        other.msm_engine.reset();
+    }
+
+    void init_msm(int n_threads, int n_tables = 1, int window = 0)
+    {
+        msm_engine.reset(
+                new MSMEngine<Curve>(powers_of_g.data(), powers_of_g.size(),
+                        n_threads, n_tables, window));
+    }
+
+    MSMEngine<Curve>& get_msm_engine()
+    {
+        if (not msm_engine)
+            init_msm(0);
+        return *msm_engine;
+    }
 };
 
 template<class T>
@@ -150,126 +182,183 @@ void ecscalarmulshare(P377Element point, Rep3Share<P377Element::Scalar> multipli
 //    return T<P377Element>(result_shares);
 //}
 
-// this is a specific, optimized function for this set of shares (although the num conversion could be better)
-template <template<class U> class T, class Curve>
-T<Curve> msm(std::vector<Curve>& bases, std::vector<T<typename Curve::Scalar>> & multipliers){
-
-    // loop through multipliers and put into separate vector
-    std::vector<typename Curve::Scalar> share1;
-    std::vector<typename Curve::Scalar> share2;
-    for (unsigned long i = 0; i < multipliers.size(); i++) {
-        // probably this conversion can be faster
-        auto ps1 = multipliers[i].get()[0];
-        auto ps2 = multipliers[i].get()[1];
-
-        share1.push_back(ps1);
-        share2.push_back(ps2);
-    }
-
-    assert(bases.size() >= multipliers.size());
+template<class T>
+std::vector<size_t> msm_lengths(const std::vector<const std::vector<T>*>& multipliers)
+{
+    std::vector<size_t> res;
+    for (auto x : multipliers)
+        res.push_back(x->size());
+    return res;
+}
 
-    // Make sure we only pass number of bases on the size of the multipliers
-    // Make a copy of bases vec of max size multipliers.size
-    std::vector<Curve> bases_short(bases.begin(), bases.begin() + multipliers.size());
-//    std::vector<P377Element::G1> bases_format(multipliers.size());
-//    for (unsigned long i = 0; i < multipliers.size(); i++) {
-//        bases_format[i] = bases[i].get_point();
-//    }
+// all replicated share components are handled in one pass over the bases
+template <template<class U> class T, class Curve>
+std::vector<T<Curve>> batch_msm(MSMEngine<Curve>& engine, const std::vector<const std::vector<T<typename Curve::Scalar>>*>& multipliers){
+    const int L = T<Curve>::vector_length;
+    auto sums = engine.run(msm_lengths(multipliers), L,
+            [&](size_t j, size_t i, int k) -> const typename Curve::Scalar& { return (*multipliers[j])[i][k]; });
+
+    std::vector<T<Curve>> res(multipliers.size());
+    for (size_t j = 0; j < multipliers.size(); j++)
+        for (int k = 0; k < L; k++)
+            res[j][k] = sums[j * L + k];
+    return res;
+}
 
-    std::cout << bases_short.size() << " and " << multipliers.size() << " and " << share1.size() << std::endl;
+template <class Curve>
+std::vector<Share<Curve>> batch_msm(MSMEngine<Curve>& engine, const std::vector<const std::vector<Share<typename Curve::Scalar>>*>& multipliers){
+    auto sums = engine.run(msm_lengths(multipliers), 2,
+            [&](size_t j, size_t i, int k) -> const typename Curve::Scalar& {
+                if (k == 0)
+                    return (*multipliers[j])[i].get_share();
+                else
+                    return (*multipliers[j])[i].get_mac();
+            });
+
+    std::vector<Share<Curve>> res;
+    for (size_t j = 0; j < multipliers.size(); j++)
+        res.push_back(Share<Curve>(SemiShare<Curve>(sums[2 * j]), SemiShare<Curve>(sums[2 * j + 1])));
+    return res;
+}
 
-    size_t parts = 1; // TODO: Make this configurable
-    if (multipliers.size() > 100000) {
-        parts = 8; // something like this?
-    }
+template <class Curve>
+std::vector<SemiShare<Curve>> batch_msm(MSMEngine<Curve>& engine, const std::vector<const std::vector<SemiShare<typename Curve::Scalar>>*>& multipliers){
+    auto sums = engine.run(msm_lengths(multipliers), 1,
+            [&](size_t j, size_t i, int) -> const typename Curve::Scalar& { return (*multipliers[j])[i]; });
 
-    Curve sum1 = libff::multi_exp<Curve, typename Curve::Scalar, libff::multi_exp_method_BDLO12>(bases_short.begin(), bases_short.end(),
-                                                                                      share1.begin(), share1.end(), parts);
-    Curve sum2 = libff::multi_exp<Curve, typename Curve::Scalar, libff::multi_exp_method_BDLO12>(bases_short.begin(), bases_short.end(),
-                                                                                                      share2.begin(), share2.end(), parts);
-    array<Curve, 2> result_shares = { Curve(sum1), Curve(sum2) };
+    return std::vector<SemiShare<Curve>>(sums.begin(), sums.end());
+}
 
-    return T<Curve>(result_shares);
+template <class Curve, class U>
+auto msm(MSMEngine<Curve>& engine, const std::vector<U>& multipliers){
+    assert(engine.size() >= multipliers.size());
+    return batch_msm(engine, std::vector<const std::vector<U>*>({&multipliers}))[0];
 }
 
-Share<P377Element> msm(std::vector<P377Element>& bases, std::vector<Share<P377Element::Scalar>> & multipliers){
 
-    std::vector<P377Element::Fr> multiplier_shares(multipliers.size());
-    std::vector<P377Element::Fr> multiplier_macs(multipliers.size());
-    for (unsigned long i = 0; i < multipliers.size(); i++) {
-        P377Element::Scalar sh = multipliers[i].get_share();
-        P377Element::Scalar m = multipliers[i].get_mac();
-        multiplier_shares[i] = libff::bls12_377_Fr(bigint(sh).get_str().c_str());
-        multiplier_macs[i] = libff::bls12_377_Fr(bigint(m).get_str().c_str());
-    }
+template<template<class U> class T, class Curve>
+T<Curve> commit_and_open(
+        const InputPolynomial<T<typename Curve::Scalar>>& tuple,
+        ECPublicParameters<Curve>& kzgPublicParameters)
+{
+    assert(tuple.coeffs.size() <= kzgPublicParameters.powers_of_g.size());
 
-    std::vector<P377Element::G1> bases_format(bases.size());
-    for (unsigned long i = 0; i < bases.size(); i++) {
-        bases_format[i] = bases[i].get_point();
-    }
+    Timer msm_timer;
+    msm_timer.start();
 
-    size_t parts = 1; // TODO: Make this configurable
-    if (multipliers.size() > 100000) {
-        parts = 8; // something like this?
-    }
-    P377Element::G1 result_share = libff::multi_exp<P377Element::G1, P377Element::Fr, libff::multi_exp_method_BDLO12>(bases_format.begin(), bases_format.end(),
-                                                                                                              multiplier_shares.begin(), multiplier_shares.end(), parts);
-    P377Element::G1 result_mac = libff::multi_exp<P377Element::G1, P377Element::Fr, libff::multi_exp_method_BDLO12>(bases_format.begin(), bases_format.end(),
-                                                                                                              multiplier_macs.begin(), multiplier_macs.end(), parts);
+    T<Curve> sum = msm(kzgPublicParameters.get_msm_engine(), tuple.coeffs);
 
-    auto semi_sh = SemiShare<P377Element>(P377Element(result_share));
-    auto semi_mac = SemiShare<P377Element>(P377Element(result_mac));
+    auto diff_msm = msm_timer.elapsed();
+    cout << "MSM took " << diff_msm * 1e3 << " ms" << endl;
 
-    return Share(semi_sh, semi_mac);
+    return sum;
 }
 
-SemiShare<P377Element> msm(std::vector<P377Element>& bases, std::vector<SemiShare<P377Element::Scalar>> & multipliers){
-
-    std::vector<P377Element::Fr> multiplier_shares(multipliers.size());
-//    std::vector<P377Element::Fr> multiplier_macs(multipliers.size());
-    for (unsigned long i = 0; i < multipliers.size(); i++) {
-        P377Element::Scalar sh = multipliers[i];
-        multiplier_shares[i] = libff::bls12_377_Fr(bigint(sh).get_str().c_str());
+// commitments to polynomials of different lengths in one pass over the bases
+template<template<class U> class T, class Curve>
+std::vector<T<Curve>> commit_batch(
+        const std::vector<InputPolynomial<T<typename Curve::Scalar>>>& tuples,
+        ECPublicParameters<Curve>& kzgPublicParameters)
+{
+    std::vector<const std::vector<T<typename Curve::Scalar>>*> multipliers;
+    for (auto& tuple : tuples) {
+        assert(tuple.coeffs.size() <= kzgPublicParameters.powers_of_g.size());
+        multipliers.push_back(&tuple.coeffs);
     }
 
-    std::vector<P377Element::G1> bases_format(bases.size());
-    for (unsigned long i = 0; i < bases.size(); i++) {
-        bases_format[i] = bases[i].get_point();
-    }
+    Timer msm_timer;
+    msm_timer.start();
 
-    size_t parts = 1; // TODO: Make this configurable
-    if (multipliers.size() > 100000) {
-        parts = 8; // something like this?
-    }
-    P377Element::G1 result_share = libff::multi_exp<P377Element::G1, P377Element::Fr, libff::multi_exp_method_BDLO12>(bases_format.begin(), bases_format.end(),
-                                                                                                                      multiplier_shares.begin(), multiplier_shares.end(), parts);
-//    P377Element::G1 result_mac = libff::multi_exp<P377Element::G1, P377Element::Fr, libff::multi_exp_method_BDLO12>(bases_format.begin(), bases_format.end(),
-//                                                                                                                    multiplier_macs.begin(), multiplier_macs.end(), parts);
+    auto res = batch_msm(kzgPublicParameters.get_msm_engine(), multipliers);
 
-    auto semi_sh = SemiShare<P377Element>(P377Element(result_share));
-//    auto semi_mac = SemiShare<P377Element>(P377Element(result_mac));
+    auto diff_msm = msm_timer.elapsed();
+    cout << "Batched MSM of " << tuples.size() << " polynomials took " << diff_msm * 1e3 << " ms" << endl;
 
-    return semi_sh;
+    return res;
 }
 
+// f(z) by Horner's rule, which is linear in the coefficients
+template<class T>
+T kzg_evaluate(const std::vector<T>& coeffs, const typename T::clear& z)
+{
+    T res;
+    for (size_t i = coeffs.size(); i > 0; i--)
+        res = coeffs[i - 1] + res * z;
+    return res;
+}
 
+// (f(X) - f(z)) / (X - z) by synthetic division
+template<class T>
+std::vector<T> kzg_quotient(const std::vector<T>& coeffs, const typename T::clear& z)
+{
+    if (coeffs.empty())
+        return {};
+    std::vector<T> res(coeffs.size() - 1);
+    T acc = coeffs.back();
+    for (size_t i = coeffs.size() - 1; i > 0; i--) {
+        res[i - 1] = acc;
+        acc = coeffs[i - 1] + acc * z;
+    }
+    return res;
+}
+
+template<class T, class U>
+class KZGBatchProof
+{
+public:
+    // values[j][i]: polynomial i at point j
+    std::vector<std::vector<T>> values;
+    // one witness per point for the combination with powers of gamma
+    std::vector<U> witnesses;
+};
+
+/*
+ * Batch opening of several polynomials at several points.
+ * For every point z, the witness commits to
+ * (sum_i gamma^i f_i(X) - sum_i gamma^i f_i(z)) / (X - z).
+ * The witness MSMs for all points run in one pass, and the result
+ * is left secret-shared to be opened together with the commitments.
+ */
 template<template<class U> class T, class Curve>
-T<Curve> commit_and_open(
-        InputPolynomial<T<typename Curve::Scalar>> tuple,
-        ECPublicParameters<Curve> kzgPublicParameters)
+KZGBatchProof<T<typename Curve::Scalar>, T<Curve>> kzg_batch_prove(
+        const std::vector<InputPolynomial<T<typename Curve::Scalar>>>& polynomials,
+        const std::vector<typename Curve::Scalar>& points,
+        const typename Curve::Scalar& gamma,
+        ECPublicParameters<Curve>& kzgPublicParameters)
 {
-    assert(tuple.coeffs.size() <= kzgPublicParameters.powers_of_g.size());
+    typedef T<typename Curve::Scalar> share_type;
+
+    size_t length = 0;
+    for (auto& polynomial : polynomials)
+        length = max(length, polynomial.coeffs.size());
+
+    std::vector<share_type> combined(length);
+    typename Curve::Scalar factor = 1;
+    for (auto& polynomial : polynomials) {
+        for (size_t i = 0; i < polynomial.coeffs.size(); i++)
+            combined[i] += polynomial.coeffs[i] * factor;
+        factor *= gamma;
+    }
 
-    Timer msm_timer;
-    msm_timer.start();
+    KZGBatchProof<share_type, T<Curve>> res;
+    std::vector<std::vector<share_type>> quotients;
+    for (auto& z : points) {
+        res.values.push_back({});
+        for (auto& polynomial : polynomials)
+            res.values.back().push_back(kzg_evaluate(polynomial.coeffs, z));
+        quotients.push_back(kzg_quotient(combined, z));
+    }
 
-    T<Curve> sum = msm(kzgPublicParameters.powers_of_g, tuple.coeffs);
+    std::vector<const std::vector<share_type>*> multipliers;
+    for (auto& quotient : quotients)
+        multipliers.push_back(&quotient);
 
-    auto diff_msm = msm_timer.elapsed();
-    cout << "MSM took " << diff_msm * 1e3 << " ms" << endl;
-    // optimize with MSM
+    Timer msm_timer;
+    msm_timer.start();
+    res.witnesses = batch_msm(kzgPublicParameters.get_msm_engine(), multipliers);
+    cout << "Witness MSM for " << points.size() << " points took " << msm_timer.elapsed() * 1e3 << " ms" << endl;
 
-    return sum;
+    return res;
 }
 
 template<template<class U> class T, class Curve>
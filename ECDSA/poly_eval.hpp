@@ -11,6 +11,7 @@
 #include "Tools/Bundle.h"
 
 #include "poly_commit.hpp"
+#include "param_cache.hpp"
 #include "Math/gfp.hpp"
 #include "Processor/Binary_File_IO.h"
 #include "PEOptions.h"
@@ -18,29 +19,6 @@
 
 //#include "sign.hpp"
 
-template<class Curve>
-Curve random_elem(PRNG& G) {
-    typename Curve::Scalar r_scalar;
-    r_scalar.randomize(G);
-    return Curve(r_scalar);
-}
-
-template<class Curve>
-inline ECPublicParameters<Curve> get_public_parameters(int n_parameters, PRNG& G) {
-    // TODO: Is this consistent across parties?
-    // It seems if we call GlobalPRNG is becomes consistent globally across parties, but it is not always called
-    // so we call it again in the auditable inference function
-
-    ECPublicParameters<Curve> params;
-    for (int i = 0; i < n_parameters; i++) {
-        params.powers_of_g.push_back(random_elem<Curve>(G));
-    }
-
-    params.g2 = random_elem<Curve>(G);
-    return params;
-}
-
-
 template<class share>
 void eval_point(
         typename share::clear beta,
@@ -54,7 +32,10 @@ void eval_point(
 //    G.SeedGlobally(P);
 
 //    test_arith();
-    std::vector<share > inputs = read_inputs<share >(P, opts.n_shares, opts.start, KZG_SUFFIX);
+    size_t n_inputs = 0;
+    for (int size : opts.poly_sizes)
+        n_inputs += size;
+    std::vector<share > inputs = read_inputs<share >(P, n_inputs, opts.start, KZG_SUFFIX);
 
     std::cout << "Share 0 " << inputs[0] << std::endl;
 
@@ -86,36 +67,44 @@ void eval_point(
 //        }
 //    }
 
-    typename share::clear r;
-    r.randomize(G);
+    // one mask per polynomial, all input in one round
+    size_t n_polys = opts.poly_sizes.size();
     set.input.reset_all(P);
-    if (opts.input_party_i == P.my_num()) {
-        set.input.add_mine(r);
-        std::cout << "input_consistency_random_value_" << opts.input_party_i << "=" << to_string(bigint(r)) << endl;
-    } else {
-        set.input.add_other(opts.input_party_i);
+    for (size_t j = 0; j < n_polys; j++) {
+        if (opts.input_party_i == P.my_num()) {
+            typename share::clear r;
+            r.randomize(G);
+            set.input.add_mine(r);
+            std::cout << "input_consistency_random_value_" << opts.input_party_i << (n_polys > 1 ? "_" + to_string(j) : "") << "=" << to_string(bigint(r)) << endl;
+        } else {
+            set.input.add_other(opts.input_party_i);
+        }
     }
     set.input.exchange();
 //    set.check();
-    share r_share = set.input.finalize(opts.input_party_i);
-
-    // Evaluate polynomial defined by inputs at beta
-    share result;
-    result += r_share;
-//    (void)r_share;
 
-    typename share::clear current_beta = beta;
-    for (int i = 0; i < opts.n_shares; i++) { // can we parallelize this?
-        result += inputs[i] * current_beta;
-        current_beta = current_beta * beta;
+    // Evaluate polynomials defined by inputs at beta
+    vector<share> results(n_polys);
+    auto coeff = inputs.begin();
+    for (size_t j = 0; j < n_polys; j++) {
+        results[j] = set.input.finalize(opts.input_party_i);
+        typename share::clear current_beta = beta;
+        for (int i = 0; i < opts.poly_sizes[j]; i++) { // can we parallelize this?
+            results[j] += *coeff++ * current_beta;
+            current_beta = current_beta * beta;
+        }
     }
 
-    set.output.init_open(P);
-    set.output.prepare_open(result);
+    // open all evaluations at once
+    set.output.init_open(P, n_polys);
+    for (auto& result : results)
+        set.output.prepare_open(result);
     set.output.exchange(P);
     set.check();
 
-    typename share::clear rho = set.output.finalize_open();
+    vector<typename share::clear> rhos;
+    for (size_t j = 0; j < n_polys; j++)
+        rhos.push_back(set.output.finalize_open());
 
     set.check();
 
@@ -128,7 +117,8 @@ void eval_point(
     print_stat("poly_eval", diff);
     print_global("poly_eval", P, diff);
 
-    std::cout << "input_consistency_player_" << opts.input_party_i << "_eval=(" << beta << "," << rho << ")" << endl;
+    for (size_t j = 0; j < n_polys; j++)
+        std::cout << "input_consistency_player_" << opts.input_party_i << "_eval" << (n_polys > 1 ? "_" + to_string(j) : "") << "=(" << beta << "," << rhos[j] << ")" << endl;
 
 }
 
@@ -2,6 +2,9 @@
 #ifndef SHARE_UTILS_HPP
 #define SHARE_UTILS_HPP
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 const string KZG_SUFFIX = "-P251";
 
 std::string addSuffixBeforeExtension(const std::string& filename, const std::string& suffix) {
@@ -30,7 +33,7 @@ void checkSignature(string filename) {
 //SOMETHING IS OFF WITH READ/WRITE SHARES
 
 template<class T>
-std::vector<T> read_inputs(Player& P, size_t size, int start, string suffix = "") {
+std::vector<T> read_inputs(Player& P, size_t size, long start, string suffix = "") {
     if (size == 0) {
         return std::vector<T>();
     }
@@ -83,6 +86,41 @@ void write_shares(Player& P, vector<T>& shares, string suffix = "", bool overwri
 
 }
 
+/*
+ * Make room for size shares from start_pos such that several threads
+ * can write disjoint ranges with write_share_range.
+ * The extension is sparse, so nothing is written yet.
+ */
+template<class T>
+void prepare_share_file(Player& P, size_t size, string suffix = "", bool overwrite = false, long start_pos = 0) {
+    const string filename_suffix = addSuffixBeforeExtension(Binary_File_IO<T>::filename(P.my_num()), suffix);
+
+    if (overwrite) {
+        ofstream outf;
+        outf.open(filename_suffix, ios::out | ios::binary | ios::trunc);
+        outf.close();
+        std::cout << "truncating output file to start from the beginning" << std::endl;
+    }
+
+    checkSignature<T>(filename_suffix);
+
+    long length = file_signature<T>().get_total_length() + (start_pos + size) * T::size();
+    struct stat st;
+    if (stat(filename_suffix.c_str(), &st) != 0)
+        throw file_error(filename_suffix);
+    if (st.st_size < length and truncate(filename_suffix.c_str(), length) != 0)
+        throw file_error(filename_suffix);
+
+    std::cout << "Reserved " << size << " shares from position " << start_pos << " with " << file_signature<T>() << " signature." << std::endl;
+}
+
+template<class T>
+void write_share_range(Player& P, const vector<T>& shares, long start_pos, string suffix = "") {
+    Binary_File_IO<T> binary_file_io = Binary_File_IO<T>();
+    const string filename_suffix = addSuffixBeforeExtension(binary_file_io.filename(P.my_num()), suffix);
+    binary_file_io.write_to_file(filename_suffix, shares, start_pos);
+}
+
 void print_timer(const string name, double elapsed_s) {
     std::cout << fixed << "TIMER (name=" << name << "_mus) (value=" << (long long)(elapsed_s * 1e6) << ")" << std::endl;
 }
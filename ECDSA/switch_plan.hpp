@@ -0,0 +1,150 @@
+/*
+ * switch_plan.hpp
+ *
+ * Resource planning for share switching
+ *
+ */
+
+#ifndef ECDSA_SWITCH_PLAN_HPP_
+#define ECDSA_SWITCH_PLAN_HPP_
+
+#include "SwitchOptions.h"
+#include "Networking/Player.h"
+#include "Tools/Bundle.h"
+
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Threads, chunk size, and edaBit batch size for converting a number of
+ * shares. Every party computes its own plan from the share count and
+ * its resources, and the parties then agree on the minimum because
+ * threads and batches have to match across parties.
+ */
+class SwitchPlan
+{
+    // malicious edaBit generation needs large batches for small buckets
+    static constexpr size_t MALICIOUS_MIN_BATCH = 10000;
+    // below this, setting up a thread costs more than it saves
+    static constexpr size_t MIN_SHARES_PER_THREAD = 500;
+    static constexpr size_t MAX_BATCH = 1 << 20;
+
+    static size_t available_memory()
+    {
+        ifstream meminfo("/proc/meminfo");
+        string key;
+        size_t value;
+        string unit;
+        while (meminfo >> key >> value >> unit)
+            if (key == "MemAvailable:")
+                return value << 10;
+        return size_t(sysconf(_SC_AVPHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+    }
+
+public:
+    int n_threads;
+    size_t chunk_size;
+    size_t edabit_batch_size;
+    size_t bytes_per_share;
+    size_t memory_budget;
+
+    // rough upper bound of memory per share in flight
+    template<class inputShare, class outputShare>
+    static size_t get_bytes_per_share(int n_bits)
+    {
+        typedef typename inputShare::bit_type::part_type bit_type;
+        size_t bit_bytes = DIV_CEIL(n_bits, bit_type::default_length)
+                * sizeof(bit_type) * bit_type::default_length / 8;
+        // input, result, opened values, and sums of bits
+        size_t conversion = sizeof(inputShare) + 3 * sizeof(outputShare)
+                + 2 * bit_bytes;
+        // edaBits consist of arithmetic and binary shares,
+        // and malicious generation keeps buckets of them
+        size_t edabit = sizeof(inputShare) + sizeof(outputShare) + bit_bytes;
+        return conversion + (inputShare::malicious ? 4 : 1) * edabit;
+    }
+
+    template<class inputShare, class outputShare>
+    static SwitchPlan make(Player& P, size_t n_shares, int n_bits,
+            const SwitchOptions& opts)
+    {
+        SwitchPlan plan;
+        plan.bytes_per_share = get_bytes_per_share<inputShare, outputShare>(
+                n_bits);
+        if (opts.max_memory > 0)
+            plan.memory_budget = size_t(opts.max_memory) << 20;
+        else
+            plan.memory_budget = available_memory() / 2;
+
+        size_t min_batch = inputShare::malicious ? MALICIOUS_MIN_BATCH : 1;
+        size_t min_per_thread = max(min_batch, MIN_SHARES_PER_THREAD);
+
+        int n_threads = opts.n_threads;
+        if (n_threads <= 0)
+            n_threads = max(1u, thread::hardware_concurrency());
+        n_threads = min<size_t>(n_threads,
+                max<size_t>(1, n_shares / min_per_thread));
+        size_t per_thread = DIV_CEIL(max<size_t>(n_shares, 1), n_threads);
+
+        // chunks of all threads have to fit into memory
+        size_t max_chunk = max<size_t>(1,
+                plan.memory_budget / n_threads / plan.bytes_per_share);
+        if (max_chunk < min_batch and n_threads > 1)
+        {
+            n_threads = max<size_t>(1,
+                    plan.memory_budget / plan.bytes_per_share / min_batch);
+            per_thread = DIV_CEIL(max<size_t>(n_shares, 1), n_threads);
+            max_chunk = max<size_t>(1,
+                    plan.memory_budget / n_threads / plan.bytes_per_share);
+        }
+
+        size_t chunk_size = per_thread;
+        if (opts.chunk_size > 0)
+            chunk_size = min<size_t>(chunk_size, opts.chunk_size);
+        chunk_size = min(chunk_size, max_chunk);
+        // same number of chunks with less imbalance
+        chunk_size = DIV_CEIL(per_thread, DIV_CEIL(per_thread, chunk_size));
+
+        // batches beyond a chunk only produce unused edaBits
+        plan.edabit_batch_size = min(chunk_size, MAX_BATCH);
+        if (opts.edabit_batch_size > 0)
+            plan.edabit_batch_size = min<size_t>(plan.edabit_batch_size,
+                    opts.edabit_batch_size);
+
+        plan.n_threads = n_threads;
+        plan.chunk_size = chunk_size;
+        plan.agree(P);
+        return plan;
+    }
+
+    void agree(Player& P)
+    {
+        Bundle<octetStream> bundle(P);
+        bundle.mine.store(n_threads);
+        bundle.mine.store(chunk_size);
+        bundle.mine.store(edabit_batch_size);
+        P.Broadcast_Receive_no_stats(bundle);
+        for (auto& os : bundle)
+        {
+            n_threads = min(n_threads, int(os.get_int(4)));
+            chunk_size = min(chunk_size, os.get_int(8));
+            edabit_batch_size = min(edabit_batch_size, os.get_int(8));
+        }
+    }
+
+    size_t memory_estimate() const
+    {
+        return n_threads * chunk_size * bytes_per_share;
+    }
+
+    void print() const
+    {
+        cout << "Switch plan: " << n_threads << " threads, chunks of "
+                << chunk_size << ", edaBit batches of " << edabit_batch_size
+                << ", about " << memory_estimate() / 1e6 << " MB of "
+                << memory_budget / 1e6 << " MB budget" << endl;
+    }
+};
+
+#endif /* ECDSA_SWITCH_PLAN_HPP_ */
@@ -187,11 +187,10 @@ void FFT_Iter(vector<modp>& ioput, int n, const vector<modp>& roots,
         {
             auto& queues = BaseMachine::s().queues;
             FftJob job(ioput, alpha2, m, PrD);
-            int start = queues.distribute(job, n / 2);
-            for (int i = start; i < n / 2; i++)
-                FFT_Iter2_body(ioput, alpha2, i, m, PrD);
-            if (start > 0)
-                queues.wrap_up(job);
+            queues.distribute_stealing(job, n / 2, [&](const ThreadJob& task) {
+                for (int i = task.begin; i < task.end; i++)
+                    FFT_Iter2_body(ioput, alpha2, i, m, PrD);
+            });
         }
         else
             for (int i = 0; i < n / 2; i++)
@@ -251,12 +250,18 @@ void BFFT(vector<modp>& ans,const vector<modp>& a,const FFT_Data& FFTD,bool forw
          { Mul(x[i],FFTD.powers[r][i],a[i],FFTD.get_prD()); }
        for (int i=a.size(); i<k2; i++)
          { assignZero(x[i],FFTD.get_prD()); }
-       FFT_Iter(x,k2,FFTD.two_root[0],FFTD.get_prD());
+       if (FFTD.get_ntt(0).active())
+         FFTD.get_ntt(0).apply(x);
+       else
+         FFT_Iter(x,k2,FFTD.two_root[0],FFTD.get_prD());
      
        for (int i=0; i<k2; i++)
           { Mul(x[i],x[i],FFTD.b[r][i],FFTD.get_prD()); }
      
-       FFT_Iter(x,k2,FFTD.two_root[1],FFTD.get_prD());
+       if (FFTD.get_ntt(1).active())
+         FFTD.get_ntt(1).apply(x);
+       else
+         FFT_Iter(x,k2,FFTD.two_root[1],FFTD.get_prD());
        
        for (int i=0; i<n; i++)
          { Mul(ans[i],x[i+n-1],FFTD.powers_i[r][i],FFTD.get_prD()); }
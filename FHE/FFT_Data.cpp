@@ -8,7 +8,7 @@
 
 
 FFT_Data::FFT_Data() :
-    twop(-1)
+    twop(-1), ntts(2)
 {
 }
 
@@ -86,6 +86,8 @@ void FFT_Data::init(const Ring& Rg,const Zp_Data& PrD)
       else
         throw bad_value();
     }
+
+  init_ntt();
 }
 
 void FFT_Data::compute_roots(int n)
@@ -96,6 +98,36 @@ void FFT_Data::compute_roots(int n)
     Mul(roots[i], roots[i - 1], root[0], prData);
 }
 
+void FFT_Data::init_ntt()
+{
+  ntts.clear();
+  ntts.resize(2);
+  if (not WordNTT::usable(prData))
+    return;
+
+  if (twop == 0 and roots.size() > size_t(phi_m()))
+    {
+      // inverse uses the square of the inverse root
+      modp root2;
+      Sqr(root2, root[1], prData);
+      vector<modp> roots2(phi_m() + 1);
+      assignOne(roots2[0], prData);
+      for (int i = 1; i <= phi_m(); i++)
+        Mul(roots2[i], roots2[i - 1], root2, prData);
+      ntts[0] = WordNTT(roots, phi_m(), prData, false);
+      ntts[1] = WordNTT(roots2, phi_m(), prData, true);
+    }
+  else if (twop > 0)
+    for (int r = 0; r < 2; r++)
+      {
+        vector<modp> roots2(twop + 1);
+        assignOne(roots2[0], prData);
+        for (int i = 1; i <= twop; i++)
+          Mul(roots2[i], roots2[i - 1], two_root[r], prData);
+        ntts[r] = WordNTT(roots2, twop, prData, true);
+      }
+}
+
 
 void FFT_Data::hash(octetStream& o) const
 {
@@ -132,6 +164,7 @@ void FFT_Data::unpack(octetStream& o)
   iphi.unpack(o);
   o.get(powers);
   o.get(powers_i);
+  init_ntt();
 }
 
 bool FFT_Data::operator!=(const FFT_Data& other) const
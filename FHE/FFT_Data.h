@@ -6,6 +6,7 @@
 #include "Math/gfpvar.h"
 #include "Math/fixint.h"
 #include "FHE/Ring.h"
+#include "FHE/NTT.h"
 
 /* Class for holding modular arithmetic data wrt the ring 
  *
@@ -35,7 +36,11 @@ class FFT_Data
   modp iphi;    // 1/phi_m mod pr
   vector< vector<modp> > powers,powers_i;
 
+  // Word-sized transforms if applicable (forward and inverse)
+  vector<WordNTT> ntts;
+
   void compute_roots(int n);
+  void init_ntt();
 
   public:
   typedef gfp T;
@@ -68,6 +73,7 @@ class FFT_Data
   modp get_root(int i) const     { return root[i];    }
   modp get_iphi() const          { return iphi;       }
   const vector<modp>& get_roots() const { return roots; }
+  const WordNTT& get_ntt(int i) const   { return ntts.at(i); }
 
   const Ring& get_R() const      { return R; }
 
@@ -0,0 +1,150 @@
+/*
+ * NTT.cpp
+ *
+ */
+
+#include "NTT.h"
+#include "Math/modp.hpp"
+#include "Tools/cpu_support.h"
+
+#ifdef __AVX512IFMA__
+#include <immintrin.h>
+#endif
+
+bool WordNTT::usable(const Zp_Data& PrD)
+{
+    return PrD.get_t() == 1 and numBits(PrD.pr) <= 62;
+}
+
+WordNTT::WordNTT(const vector<modp>& roots, int n, const Zp_Data& PrD,
+        bool start_with_one) :
+        p(PrD.pr.get_ui()), n(n)
+{
+    assert(usable(PrD));
+    assert(roots.size() > size_t(n));
+    assert((n & (n - 1)) == 0);
+
+    bool small = p < (1ull << 50);
+    w.resize(max(n - 1, 0));
+    w_shoup.resize(w.size());
+    if (small)
+        w_shoup52.resize(w.size());
+
+    bigint tmp;
+    for (int m = 2; m <= n; m *= 2)
+    {
+        int h = m / 2;
+        for (int j = 0; j < h; j++)
+        {
+            auto& root = start_with_one ?
+                    roots[j * n / m] : roots.at((2 * j + 1) * (n / m));
+            to_bigint(tmp, root, PrD);
+            uint64_t x = tmp.get_ui();
+            w[h - 1 + j] = x;
+            w_shoup[h - 1 + j] = ((__uint128_t) x << 64) / p;
+            if (small)
+                w_shoup52[h - 1 + j] = ((__uint128_t) x << 52) / p;
+        }
+    }
+
+    bit_reversal.resize(n);
+    int log_n = 0;
+    while ((1 << log_n) < n)
+        log_n++;
+    for (int i = 0; i < n; i++)
+    {
+        int r = 0;
+        for (int b = 0; b < log_n; b++)
+            r |= ((i >> b) & 1) << (log_n - 1 - b);
+        bit_reversal[i] = r;
+    }
+}
+
+bool WordNTT::use_ifma() const
+{
+#ifdef __AVX512IFMA__
+    return not w_shoup52.empty() and cpu_has_avx512ifma();
+#else
+    return false;
+#endif
+}
+
+void WordNTT::stage(uint64_t* a, int h) const
+{
+    uint64_t two_p = 2 * p;
+    auto ws = &w[h - 1], ws_shoup = &w_shoup[h - 1];
+    for (int k = 0; k < n; k += 2 * h)
+        for (int j = 0; j < h; j++)
+        {
+            uint64_t x = a[k + j], y = a[k + j + h];
+            x -= x >= two_p ? two_p : 0;
+            uint64_t q = ((__uint128_t) y * ws_shoup[j]) >> 64;
+            uint64_t t = y * ws[j] - q * p;
+            a[k + j] = x + t;
+            a[k + j + h] = x - t + two_p;
+        }
+}
+
+void WordNTT::stage_ifma(uint64_t* a, int h) const
+{
+#ifdef __AVX512IFMA__
+    auto two_p = _mm512_set1_epi64(2 * p);
+    auto pp = _mm512_set1_epi64(p);
+    auto mask = _mm512_set1_epi64((1ull << 52) - 1);
+    auto zero = _mm512_setzero_si512();
+    auto ws = &w[h - 1], ws_shoup = &w_shoup52[h - 1];
+    for (int k = 0; k < n; k += 2 * h)
+        for (int j = 0; j < h; j += 8)
+        {
+            auto x = _mm512_loadu_si512(a + k + j);
+            auto y = _mm512_loadu_si512(a + k + j + h);
+            auto w = _mm512_loadu_si512(ws + j);
+            auto w_shoup = _mm512_loadu_si512(ws_shoup + j);
+            // masked form avoids a false uninitialized warning
+            x = _mm512_maskz_min_epu64(0xFF, x, _mm512_sub_epi64(x, two_p));
+            auto q = _mm512_madd52hi_epu64(zero, y, w_shoup);
+            auto t = _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, y, w),
+                    _mm512_madd52lo_epu64(zero, q, pp));
+            t = _mm512_and_si512(t, mask);
+            _mm512_storeu_si512(a + k + j, _mm512_add_epi64(x, t));
+            _mm512_storeu_si512(a + k + j + h,
+                    _mm512_add_epi64(_mm512_sub_epi64(x, t), two_p));
+        }
+#else
+    (void) a, (void) h;
+    throw runtime_error("not compiled with AVX-512 IFMA");
+#endif
+}
+
+void WordNTT::reduce(uint64_t* a) const
+{
+    uint64_t two_p = 2 * p;
+    for (int i = 0; i < n; i++)
+    {
+        uint64_t x = a[i];
+        x -= x >= two_p ? two_p : 0;
+        x -= x >= p ? p : 0;
+        a[i] = x;
+    }
+}
+
+void WordNTT::apply(vector<modp>& ioput) const
+{
+    assert(active());
+    assert(ioput.size() >= size_t(n));
+
+    vector<uint64_t> a(n);
+    for (int i = 0; i < n; i++)
+        a[i] = ioput[bit_reversal[i]].get()[0];
+
+    bool ifma = use_ifma();
+    for (int h = 1; h < n; h *= 2)
+        if (ifma and h >= 8)
+            stage_ifma(a.data(), h);
+        else
+            stage(a.data(), h);
+
+    reduce(a.data());
+    for (int i = 0; i < n; i++)
+        ioput[i].assign(&a[i], 1);
+}
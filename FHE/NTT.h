@@ -0,0 +1,56 @@
+/*
+ * NTT.h
+ *
+ */
+
+#ifndef FHE_NTT_H_
+#define FHE_NTT_H_
+
+#include "Math/modp.h"
+#include "Math/Zp_Data.h"
+
+#include <vector>
+using namespace std;
+
+/*
+ * Number-theoretic transform for primes below 2^62, equivalent to
+ * FFT_Iter() with precomputed roots. It uses Harvey's lazy butterflies
+ * keeping values in [0, 4p) with Shoup's precomputation for the
+ * twiddle factors, and AVX-512 IFMA for primes below 2^50 if available.
+ * The transform is linear, so Montgomery representation can be kept.
+ */
+class WordNTT
+{
+    uint64_t p;
+    int n;
+
+    // twiddle factors for butterflies of distance h at offset h - 1
+    vector<uint64_t> w, w_shoup, w_shoup52;
+    vector<int> bit_reversal;
+
+    bool use_ifma() const;
+
+    void stage(uint64_t* a, int h) const;
+    void stage_ifma(uint64_t* a, int h) const;
+    void reduce(uint64_t* a) const;
+
+public:
+    static bool usable(const Zp_Data& PrD);
+
+    WordNTT() :
+            p(0), n(0)
+    {
+    }
+
+    WordNTT(const vector<modp>& roots, int n, const Zp_Data& PrD,
+            bool start_with_one);
+
+    bool active() const
+    {
+        return n > 0;
+    }
+
+    void apply(vector<modp>& ioput) const;
+};
+
+#endif /* FHE_NTT_H_ */
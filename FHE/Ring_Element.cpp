@@ -26,6 +26,53 @@ void reduce(vector<modp>& aa, int top, int bottom, const FFT_Data& FFTD)
 }
 
 
+// the pool might be gone when destructing static elements
+thread_local bool ring_buffer_pool_destroyed = false;
+
+RingBufferPool* RingBufferPool::get()
+{
+  static thread_local RingBufferPool pool;
+  if (ring_buffer_pool_destroyed)
+    return 0;
+  return &pool;
+}
+
+RingBufferPool::~RingBufferPool()
+{
+  ring_buffer_pool_destroyed = true;
+}
+
+void RingBufferPool::acquire(vector<modp>& element, size_t size)
+{
+  assert(element.empty());
+  if (element.capacity() >= size)
+    return;
+  auto pool = get();
+  if (pool)
+    for (auto it = pool->buffers.begin(); it != pool->buffers.end(); it++)
+      if (it->capacity() >= size)
+        {
+          element.swap(*it);
+          pool->buffers.erase(it);
+          return;
+        }
+  element.reserve(size);
+}
+
+void RingBufferPool::release(vector<modp>& element)
+{
+  if (element.capacity() == 0)
+    return;
+  auto pool = get();
+  if (pool and pool->buffers.size() < MAX_BUFFERS)
+    {
+      element.clear();
+      pool->buffers.push_back({});
+      pool->buffers.back().swap(element);
+    }
+}
+
+
 Ring_Element::Ring_Element(const FFT_Data& fftd,RepType r)
 { 
   FFTD=&fftd;
@@ -34,6 +81,27 @@ Ring_Element::Ring_Element(const FFT_Data& fftd,RepType r)
 }
 
 
+Ring_Element::Ring_Element(const Ring_Element& other) :
+    rep(other.rep), FFTD(other.FFTD)
+{
+  RingBufferPool::acquire(element, other.element.size());
+  element = other.element;
+}
+
+
+Ring_Element& Ring_Element::operator=(const Ring_Element& other)
+{
+  if (this == &other)
+    return *this;
+  rep = other.rep;
+  FFTD = other.FFTD;
+  element.clear();
+  RingBufferPool::acquire(element, other.element.size());
+  element = other.element;
+  return *this;
+}
+
+
 void Ring_Element::prepare(const Ring_Element& other)
 {
   assert(this != &other);
@@ -46,13 +114,15 @@ void Ring_Element::prepare_push()
 {
   element.clear();
   assert(FFTD);
-  element.reserve(FFTD->phi_m());
+  RingBufferPool::acquire(element, FFTD->phi_m());
 }
 
 
 void Ring_Element::allocate()
 {
   assert(FFTD);
+  if (element.empty())
+    RingBufferPool::acquire(element, FFTD->phi_m());
   element.resize(FFTD->phi_m());
 }
 
@@ -385,7 +455,11 @@ void Ring_Element::change_rep(RepType r)
     { rep=evaluation;
       if ((*FFTD).get_twop()==0)
         { // m a power of two variant
-          FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_roots(),(*FFTD).get_prD());
+          auto& ntt = (*FFTD).get_ntt(0);
+          if (ntt.active())
+            ntt.apply(element);
+          else
+            FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_roots(),(*FFTD).get_prD());
 	}
       else
         { // Non m power of two variant and FFT enabled
@@ -396,9 +470,15 @@ void Ring_Element::change_rep(RepType r)
     { rep=polynomial;
       if ((*FFTD).get_twop()==0)
 	{ // m a power of two variant
-          modp root2;
-          Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
-          FFT_Iter(element, (*FFTD).phi_m(),root2,(*FFTD).get_prD());
+          auto& ntt = (*FFTD).get_ntt(1);
+          if (ntt.active())
+            ntt.apply(element);
+          else
+            {
+              modp root2;
+              Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
+              FFT_Iter(element, (*FFTD).phi_m(),root2,(*FFTD).get_prD());
+            }
           modp w;
           w = (*FFTD).get_iphi();
           for (int i=0; i<(*FFTD).phi_m(); i++)
@@ -517,7 +597,15 @@ modp Ring_Element::get_constant() const
 void store(octetStream& o,const vector<modp>& v,const Zp_Data& ZpD)
 {
   ZpD.pack(o);
-  o.store(v);
+  o.store(v.size());
+  // only the significant limbs, packed contiguously
+  size_t length = ZpD.get_t() * sizeof(mp_limb_t);
+  octet* buffer = o.append(v.size() * length);
+  for (auto& x : v)
+    {
+      memcpy(buffer, x.get(), length);
+      buffer += length;
+    }
 }
 
 
@@ -529,7 +617,19 @@ void get(octetStream& o,vector<modp>& v,const Zp_Data& ZpD)
     throw runtime_error(
         "mismatch: " + to_string(check_Zpd.pr_bit_length) + "/"
             + to_string(ZpD.pr_bit_length));
-  o.get(v);
+  size_t size;
+  o.get(size);
+  size_t length = ZpD.get_t() * sizeof(mp_limb_t);
+  if (size > o.left() / length)
+    throw runtime_error("insufficient data");
+  octet* buffer = o.consume(size * length);
+  v.clear();
+  v.resize(size);
+  for (auto& x : v)
+    {
+      x.assign(buffer, ZpD.get_t());
+      buffer += length;
+    }
 }
 
 
@@ -549,6 +649,8 @@ void Ring_Element::unpack(octetStream& o)
   o.get(a);
   rep=(RepType) a;
   check_rep();
+  element.clear();
+  RingBufferPool::acquire(element, FFTD->phi_m());
   get(o,element,(*FFTD).get_prD());
   check_size();
 }
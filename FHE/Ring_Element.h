@@ -25,6 +25,26 @@ using namespace std;
 class RingWriteIterator;
 class RingReadIterator;
 
+/* Recycles coefficient buffers of ring elements per thread
+ * in order to avoid allocating for every temporary element
+ * in ciphertext arithmetic
+ */
+class RingBufferPool
+{
+  static const size_t MAX_BUFFERS = 8;
+
+  vector<vector<modp>> buffers;
+
+  static RingBufferPool* get();
+
+  public:
+  ~RingBufferPool();
+
+  // provide capacity for an empty vector
+  static void acquire(vector<modp>& element, size_t size);
+  static void release(vector<modp>& element);
+};
+
 class Ring_Element
 {
   friend class Rq_Element;
@@ -70,12 +90,20 @@ class Ring_Element
 
   Ring_Element(const FFT_Data& prd,RepType r=polynomial);
 
+  Ring_Element(const Ring_Element& other);
+  Ring_Element(Ring_Element&& other) = default;
+  ~Ring_Element() { RingBufferPool::release(element); }
+
+  Ring_Element& operator=(const Ring_Element& other);
+  Ring_Element& operator=(Ring_Element&& other);
+
   template<class T>
   Ring_Element(const FFT_Data& prd, RepType r, const vector<T>& other)
     {
       assert(size_t(prd.num_slots()) == other.size());
       FFTD = &prd;
       rep = r;
+      RingBufferPool::acquire(element, other.size());
       for (auto& x : other)
         element.push_back({x, FFTD->get_prD()});
     }
@@ -189,6 +217,16 @@ public:
 };
 
 
+inline Ring_Element& Ring_Element::operator=(Ring_Element&& other)
+{
+  rep = other.rep;
+  FFTD = other.FFTD;
+  RingBufferPool::release(element);
+  element = move(other.element);
+  return *this;
+}
+
+
 inline void mul(Ring_Element& ans,const modp& a,const Ring_Element& b)
 { mul(ans,b,a); }
 
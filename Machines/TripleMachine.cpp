@@ -117,6 +117,16 @@ TripleMachine::TripleMachine(int argc, const char** argv) :
         "-S", // Flag token.
         "--security" // Flag token.
     );
+    opt.add(
+        "SoftSpokenOT", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "OT extension: SoftSpokenOT (default), KOS15, "
+                "or Silent (passive only)", // Help description.
+        "-O", // Flag token.
+        "--ot-extension" // Flag token.
+    );
 
     parse_options(argc, argv);
 
@@ -140,6 +150,18 @@ TripleMachine::TripleMachine(int argc, const char** argv) :
     if (opt.isSet("-S"))
         opt.get("-S")->getInt(z2s);
 
+    string ot_extension;
+    opt.get("-O")->getString(ot_extension);
+    if (ot_extension == "KOS15")
+        OnlineOptions::singleton.options.push_back("use_kos");
+    else if (ot_extension == "Silent")
+        OnlineOptions::singleton.options.push_back("silent_ot");
+    else if (ot_extension != "SoftSpokenOT")
+    {
+        cerr << "Unknown OT extension: " << ot_extension << endl;
+        exit(1);
+    }
+
     // doesn't work with Montgomery multiplication
     if (prime)
         gfpvar1::init_field(prime, false);
@@ -236,6 +258,9 @@ void TripleMachine::run()
     for (int i = 0; i < nthreads; i++)
         generators[i]->wait();
     cout << "Starting computation" << endl;
+    size_t sent_before = 0;
+    for (auto generator : generators)
+        sent_before += generator->data_sent();
     gettimeofday(&start, 0);
     for (int i = 0; i < nthreads; i++)
     {
@@ -250,6 +275,11 @@ void TripleMachine::run()
         cout << "thread " << i+1 << " finished\n" << flush;
     }
 
+    size_t sent = 0;
+    for (auto generator : generators)
+        sent += generator->data_sent();
+    sent -= sent_before;
+
     map<string,Timer>& timers = generators[0]->timers;
     for (map<string,Timer>::iterator it = timers.begin(); it != timers.end(); it++)
     {
@@ -264,6 +294,7 @@ void TripleMachine::run()
     double time = timeval_diff_in_seconds(&start, &stop);
     cout << "Time: " << time << endl;
     cout << "Throughput: " << ntriples / time << endl;
+    cout << "Data sent: " << sent * 1e-6 << " MB" << endl;
 
     for (size_t i = 0; i < generators.size(); i++)
         delete generators[i];
@@ -373,5 +373,6 @@
 #include "Yao/YaoGarbleWire.h"
 #include "Yao/YaoGate.h"
 #include "Yao/YaoHalfGate.h"
+#include "Yao/YaoThreeHalvesGate.h"
 #include "Yao/YaoPlayer.h"
 #include "Yao/YaoWire.h"
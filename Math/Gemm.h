@@ -0,0 +1,61 @@
+/*
+ * Gemm.h
+ *
+ */
+
+#ifndef MATH_GEMM_H_
+#define MATH_GEMM_H_
+
+#include "Tools/int.h"
+
+#include <stddef.h>
+#include <algorithm>
+using namespace std;
+
+/**
+ * Blocked local matrix product ``C += A * B`` with row-major ``A``
+ * (``n`` x ``m``), ``B`` (``m`` x ``l``), and ``C`` (``n`` x ``l``).
+ * It only uses lazy operations, so the caller has to normalize
+ * the results. The innermost loop runs along rows of ``B`` and ``C``
+ * for vectorization, and tiles of ``C`` are distributed among threads.
+ */
+template<class T>
+void gemm_add(T* C, const T* A, const T* B, size_t n, size_t m, size_t l,
+        int n_threads = 1)
+{
+    // blocks of B should stay in L2 cache
+    const size_t BLOCK_I = 16, BLOCK_K = max<size_t>(1, (1 << 14) / sizeof(T)),
+            BLOCK_J = 256;
+
+    // split along both dimensions of C so that products with few rows
+    // such as convolutions still use all threads
+    long n_row_blocks = DIV_CEIL(n, BLOCK_I);
+    long n_column_blocks = DIV_CEIL(l, BLOCK_J);
+    long n_blocks = n_row_blocks * n_column_blocks;
+
+#pragma omp parallel for num_threads(n_threads) if(n_threads > 1 and n_blocks > 1) schedule(dynamic)
+    for (long block = 0; block < n_blocks; block++)
+    {
+        size_t i_begin = block / n_column_blocks * BLOCK_I;
+        size_t i_end = min(n, i_begin + BLOCK_I);
+        size_t j_begin = block % n_column_blocks * BLOCK_J;
+        size_t j_end = min(l, j_begin + BLOCK_J);
+        for (size_t k_begin = 0; k_begin < m; k_begin += BLOCK_K)
+        {
+            size_t k_end = min(m, k_begin + BLOCK_K);
+            for (size_t i = i_begin; i < i_end; i++)
+            {
+                T* c = C + i * l;
+                for (size_t k = k_begin; k < k_end; k++)
+                {
+                    auto a = A[i * m + k];
+                    auto b = B + k * l;
+                    for (size_t j = j_begin; j < j_end; j++)
+                        c[j] = c[j].lazy_add(a.lazy_mul(b[j]));
+                }
+            }
+        }
+    }
+}
+
+#endif /* MATH_GEMM_H_ */
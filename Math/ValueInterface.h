@@ -42,6 +42,55 @@ public:
     void normalize() {}
 
     void randomize_part(PRNG&, int) { throw not_implemented(); }
+
+    template<class T>
+    static void randomize_many(PRNG& G, T* res, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i].randomize(G);
+    }
+
+    // element-wise operations on arrays with strides
+    template<class T, class U, class V>
+    static void add_many(T* res, const U* x, const V* y, size_t n,
+            size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i * res_stride] = x[i * x_stride] + y[i * y_stride];
+    }
+
+    template<class T, class U, class V>
+    static void sub_many(T* res, const U* x, const V* y, size_t n,
+            size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i * res_stride] = x[i * x_stride] - y[i * y_stride];
+    }
+
+    template<class T, class U, class V>
+    static void mul_many(T* res, const U* x, const V* y, size_t n,
+            size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i * res_stride] = x[i * x_stride] * y[i * y_stride];
+    }
+
+    template<class T, class U, class V>
+    static void mul_add_many(T* res, const U* x, const V* y, size_t n,
+            size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i * res_stride] += x[i * x_stride] * y[i * y_stride];
+    }
+
+    template<class T, class U, class V>
+    static void dot_product(T& res, const U* x, const V* y, size_t n,
+            size_t x_stride = 1, size_t y_stride = 1)
+    {
+        res = {};
+        for (size_t i = 0; i < n; i++)
+            res += x[i * x_stride] * y[i * y_stride];
+    }
 };
 
 #endif /* MATH_VALUEINTERFACE_H_ */
@@ -190,6 +190,7 @@ public:
 	 */
 	void randomize(PRNG& G, int n = -1);
 	void randomize_part(PRNG& G, int n);
+	static void randomize_many(PRNG& G, Z2* res, size_t n);
 	void almost_randomize(PRNG& G) { randomize(G); }
 
 	void force_to_bit() { throw runtime_error("impossible"); }
@@ -477,6 +478,24 @@ void Z2<K>::randomize(PRNG& G, int n)
 	normalize_byte();
 }
 
+template<int K>
+void Z2<K>::randomize_many(PRNG& G, Z2* res, size_t n)
+{
+	if (N_BYTES == sizeof(Z2))
+	{
+		// consecutive candidates without gaps
+		size_t step = (1 << 20) / sizeof(Z2);
+		for (size_t i = 0; i < n; i += step)
+			G.get_octets((octet*) (res + i), min(step, n - i) * sizeof(Z2));
+		// clear the bits above K as in randomize()
+		for (size_t i = 0; i < n; i++)
+			res[i].normalize_byte();
+	}
+	else
+		for (size_t i = 0; i < n; i++)
+			res[i].randomize(G);
+}
+
 template<int K>
 void Z2<K>::randomize_part(PRNG& G, int n)
 {
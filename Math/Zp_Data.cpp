@@ -2,6 +2,210 @@
 #include "Zp_Data.h"
 #include "mpn_fixed.h"
 #include "gf2nlong.h"
+#include "Tools/cpu_support.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+
+namespace
+{
+
+/*
+ * Eight elements with T limbs, one per lane. Products use radix 2^52
+ * for AVX-512 IFMA. Shifting the first factor by E bits on input makes
+ * the Montgomery reduction by 2^(52N) equivalent to the one by 2^(64T)
+ * in Zp_Data::Mont_Mult_(), so the results are identical.
+ * Masked forms of shifts and gathers avoid false uninitialized
+ * warnings with GCC.
+ */
+template<int T>
+class ZpBatch
+{
+public:
+  static const int N = 64 * T / 52 + 1;
+  static const int E = 52 * N - 64 * T;
+
+private:
+  __m512i p[T], zero, one;
+#ifdef __AVX512IFMA__
+  __m512i p52[N], m, mask;
+
+  // left shift by n bits, right shift for negative n
+  static __m512i shift(__m512i x, int n)
+  {
+    if (n >= 0)
+      return _mm512_maskz_sll_epi64(0xFF, x, _mm_cvtsi32_si128(n));
+    else
+      return _mm512_maskz_srl_epi64(0xFF, x, _mm_cvtsi32_si128(-n));
+  }
+
+  // digits of x * 2^e
+  void to_digits(__m512i* res, const __m512i* x, int e) const
+  {
+    for (int k = 0; k < N; k++)
+      {
+        res[k] = zero;
+        for (int j = 0; j < T; j++)
+          {
+            int n = 64 * j + e - 52 * k;
+            if (n > -64 and n < 52)
+              res[k] = _mm512_or_si512(res[k], shift(x[j], n));
+          }
+        res[k] = _mm512_and_si512(res[k], mask);
+      }
+  }
+
+  void from_digits(__m512i* res, const __m512i* x) const
+  {
+    for (int j = 0; j < T; j++)
+      {
+        res[j] = zero;
+        for (int k = 0; k < N; k++)
+          {
+            int n = 52 * k - 64 * j;
+            if (n > -52 and n < 64)
+              res[j] = _mm512_or_si512(res[j], shift(x[k], n));
+          }
+      }
+  }
+#endif
+
+public:
+  static __m512i indices(size_t stride)
+  {
+    long long s = stride;
+    return _mm512_set_epi64(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+  }
+
+  ZpBatch(const mp_limb_t* prA, mp_limb_t pi)
+  {
+    zero = _mm512_setzero_si512();
+    one = _mm512_set1_epi64(1);
+    for (int j = 0; j < T; j++)
+      p[j] = _mm512_set1_epi64(prA[j]);
+#ifdef __AVX512IFMA__
+    mask = _mm512_set1_epi64((1ll << 52) - 1);
+    m = _mm512_and_si512(_mm512_set1_epi64(pi), mask);
+    to_digits(p52, p, 0);
+#else
+    (void) pi;
+#endif
+  }
+
+  void load(__m512i* res, const mp_limb_t* x, __m512i indices) const
+  {
+    for (int j = 0; j < T; j++)
+      res[j] = _mm512_mask_i64gather_epi64(zero, 0xFF, indices,
+          (const long long*) (x + j), 8);
+  }
+
+  void store(mp_limb_t* x, __m512i indices, const __m512i* limbs) const
+  {
+    for (int j = 0; j < T; j++)
+      _mm512_i64scatter_epi64((long long*) (x + j), indices, limbs[j], 8);
+  }
+
+  // x + y for x, y < p
+  void add(__m512i* res, const __m512i* x, const __m512i* y) const
+  {
+    __m512i s[T], d[T];
+    __mmask8 carry = 0, borrow = 0;
+    for (int j = 0; j < T; j++)
+      {
+        s[j] = _mm512_add_epi64(x[j], y[j]);
+        __mmask8 c = _mm512_cmplt_epu64_mask(s[j], x[j]);
+        s[j] = _mm512_mask_add_epi64(s[j], carry, s[j], one);
+        carry = c | (carry & _mm512_cmpeq_epi64_mask(s[j], zero));
+        d[j] = _mm512_sub_epi64(s[j], p[j]);
+        __mmask8 b = _mm512_cmplt_epu64_mask(s[j], p[j]);
+        b |= borrow & _mm512_cmpeq_epi64_mask(d[j], zero);
+        d[j] = _mm512_mask_sub_epi64(d[j], borrow, d[j], one);
+        borrow = b;
+      }
+    __mmask8 reduce = carry | __mmask8(~borrow);
+    for (int j = 0; j < T; j++)
+      res[j] = _mm512_mask_mov_epi64(s[j], reduce, d[j]);
+  }
+
+  // x - y for x, y < p
+  void sub(__m512i* res, const __m512i* x, const __m512i* y) const
+  {
+    __m512i d[T], s[T];
+    __mmask8 borrow = 0, carry = 0;
+    for (int j = 0; j < T; j++)
+      {
+        d[j] = _mm512_sub_epi64(x[j], y[j]);
+        __mmask8 b = _mm512_cmplt_epu64_mask(x[j], y[j]);
+        b |= borrow & _mm512_cmpeq_epi64_mask(d[j], zero);
+        d[j] = _mm512_mask_sub_epi64(d[j], borrow, d[j], one);
+        borrow = b;
+      }
+    // the final carry cancels the borrow
+    for (int j = 0; j < T; j++)
+      {
+        s[j] = _mm512_add_epi64(d[j], p[j]);
+        __mmask8 c = _mm512_cmplt_epu64_mask(s[j], d[j]);
+        s[j] = _mm512_mask_add_epi64(s[j], carry, s[j], one);
+        carry = c | (carry & _mm512_cmpeq_epi64_mask(s[j], zero));
+      }
+    for (int j = 0; j < T; j++)
+      res[j] = _mm512_mask_mov_epi64(d[j], borrow, s[j]);
+  }
+
+#ifdef __AVX512IFMA__
+  // Montgomery product for x < 2^(64T) and y < p
+  void mul(__m512i* res, const __m512i* x, const __m512i* y) const
+  {
+    __m512i a[N], b[N], acc[N + 1];
+    to_digits(a, x, E);
+    to_digits(b, y, 0);
+    for (auto& c : acc)
+      c = zero;
+    for (int i = 0; i < N; i++)
+      {
+        for (int j = 0; j < N; j++)
+          {
+            acc[j] = _mm512_madd52lo_epu64(acc[j], a[i], b[j]);
+            acc[j + 1] = _mm512_madd52hi_epu64(acc[j + 1], a[i], b[j]);
+          }
+        __m512i u = _mm512_madd52lo_epu64(zero, acc[0], m);
+        for (int j = 0; j < N; j++)
+          {
+            acc[j] = _mm512_madd52lo_epu64(acc[j], u, p52[j]);
+            acc[j + 1] = _mm512_madd52hi_epu64(acc[j + 1], u, p52[j]);
+          }
+        // the lowest digit is a multiple of 2^52 now
+        acc[1] = _mm512_add_epi64(acc[1],
+            _mm512_maskz_srli_epi64(0xFF, acc[0], 52));
+        for (int j = 0; j < N; j++)
+          acc[j] = acc[j + 1];
+        acc[N] = zero;
+      }
+
+    // carries and subtraction of p if necessary, the result is below 2p
+    for (int j = 0; j < N - 1; j++)
+      {
+        acc[j + 1] = _mm512_add_epi64(acc[j + 1],
+            _mm512_maskz_srli_epi64(0xFF, acc[j], 52));
+        acc[j] = _mm512_and_si512(acc[j], mask);
+      }
+    __m512i d[N], borrow = zero;
+    for (int j = 0; j < N; j++)
+      {
+        d[j] = _mm512_sub_epi64(_mm512_sub_epi64(acc[j], p52[j]), borrow);
+        borrow = _mm512_maskz_srli_epi64(0xFF, d[j], 63);
+        d[j] = _mm512_and_si512(d[j], mask);
+      }
+    __mmask8 reduce = _mm512_cmpeq_epi64_mask(borrow, zero);
+    for (int j = 0; j < N; j++)
+      acc[j] = _mm512_mask_mov_epi64(acc[j], reduce, d[j]);
+    from_digits(res, acc);
+  }
+#endif
+};
+
+}
+#endif
 
 
 void Zp_Data::init(const bigint& p,bool mont)
@@ -129,6 +333,197 @@ void Zp_Data::Mont_Mult_switch(mp_limb_t* z, const mp_limb_t* x,
 }
 
 
+template<int T>
+void Zp_Data::Add_many_(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+    size_t n, size_t sz, size_t sx, size_t sy, bool sub) const
+{
+  size_t i = 0;
+#ifdef __AVX512F__
+  if (n >= 8)
+    {
+      ZpBatch<T> B(prA, pi);
+      auto iz = B.indices(sz), ix = B.indices(sx), iy = B.indices(sy);
+      for (; i + 8 <= n; i += 8)
+        {
+          __m512i a[T], b[T];
+          B.load(a, x + i * sx, ix);
+          B.load(b, y + i * sy, iy);
+          if (sub)
+            B.sub(a, a, b);
+          else
+            B.add(a, a, b);
+          B.store(z + i * sz, iz, a);
+        }
+    }
+#endif
+  for (; i < n; i++)
+    if (sub)
+      Sub<T>(z + i * sz, x + i * sx, y + i * sy);
+    else
+      Add<T>(z + i * sz, x + i * sx, y + i * sy);
+}
+
+void Zp_Data::Add_many(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+    size_t n, size_t sz, size_t sx, size_t sy) const
+{
+  switch (t)
+  {
+#define X(L) case L: Add_many_<L>(z, x, y, n, sz, sx, sy, false); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    for (size_t i = 0; i < n; i++)
+      Add(z + i * sz, x + i * sx, y + i * sy);
+  }
+}
+
+void Zp_Data::Sub_many(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+    size_t n, size_t sz, size_t sx, size_t sy) const
+{
+  switch (t)
+  {
+#define X(L) case L: Add_many_<L>(z, x, y, n, sz, sx, sy, true); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    for (size_t i = 0; i < n; i++)
+      Sub(z + i * sz, x + i * sx, y + i * sy);
+  }
+}
+
+template<int T>
+void Zp_Data::Mont_Mult_many_(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, size_t sz, size_t sx, size_t sy,
+    bool add) const
+{
+  size_t i = 0;
+#ifdef __AVX512IFMA__
+  if (n >= 8 and cpu_has_avx512ifma())
+    {
+      ZpBatch<T> B(prA, pi);
+      auto iz = B.indices(sz), ix = B.indices(sx), iy = B.indices(sy);
+      for (; i + 8 <= n; i += 8)
+        {
+          __m512i a[T], b[T];
+          B.load(a, x + i * sx, ix);
+          B.load(b, y + i * sy, iy);
+          B.mul(a, a, b);
+          if (add)
+            {
+              B.load(b, z + i * sz, iz);
+              B.add(a, a, b);
+            }
+          B.store(z + i * sz, iz, a);
+        }
+    }
+#endif
+  mp_limb_t tmp[T];
+  for (; i < n; i++)
+    if (add)
+      {
+        Mont_Mult_<T>(tmp, x + i * sx, y + i * sy);
+        Add<T>(z + i * sz, z + i * sz, tmp);
+      }
+    else
+      Mont_Mult_<T>(z + i * sz, x + i * sx, y + i * sy);
+}
+
+void Zp_Data::Mont_Mult_many(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, size_t sz, size_t sx, size_t sy) const
+{
+  assert(montgomery);
+  switch (t)
+  {
+#define X(L) case L: Mont_Mult_many_<L>(z, x, y, n, sz, sx, sy, false); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    for (size_t i = 0; i < n; i++)
+      Mont_Mult(z + i * sz, x + i * sx, y + i * sy);
+  }
+}
+
+void Zp_Data::Mont_Mult_add_many(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, size_t sz, size_t sx, size_t sy) const
+{
+  assert(montgomery);
+  switch (t)
+  {
+#define X(L) case L: Mont_Mult_many_<L>(z, x, y, n, sz, sx, sy, true); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    mp_limb_t tmp[MAX_MOD_SZ];
+    for (size_t i = 0; i < n; i++)
+      {
+        Mont_Mult(tmp, x + i * sx, y + i * sy);
+        Add(z + i * sz, z + i * sz, tmp);
+      }
+  }
+}
+
+template<int T>
+void Zp_Data::Mont_Mult_sum_(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, size_t sx, size_t sy) const
+{
+  mp_limb_t res[T], tmp[T];
+  inline_mpn_zero(res, T);
+  size_t i = 0;
+#ifdef __AVX512IFMA__
+  if (n >= 8 and cpu_has_avx512ifma())
+    {
+      // one sum per lane
+      ZpBatch<T> B(prA, pi);
+      auto ix = B.indices(sx), iy = B.indices(sy);
+      __m512i acc[T], a[T], b[T];
+      for (auto& c : acc)
+        c = _mm512_setzero_si512();
+      for (; i + 8 <= n; i += 8)
+        {
+          B.load(a, x + i * sx, ix);
+          B.load(b, y + i * sy, iy);
+          B.mul(a, a, b);
+          B.add(acc, acc, a);
+        }
+      mp_limb_t lanes[T][8];
+      for (int k = 0; k < T; k++)
+        _mm512_storeu_si512(lanes[k], acc[k]);
+      for (int j = 0; j < 8; j++)
+        {
+          for (int k = 0; k < T; k++)
+            tmp[k] = lanes[k][j];
+          Add<T>(res, res, tmp);
+        }
+    }
+#endif
+  for (; i < n; i++)
+    {
+      Mont_Mult_<T>(tmp, x + i * sx, y + i * sy);
+      Add<T>(res, res, tmp);
+    }
+  inline_mpn_copyi(z, res, T);
+}
+
+void Zp_Data::Mont_Mult_sum(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, size_t sx, size_t sy) const
+{
+  assert(montgomery);
+  switch (t)
+  {
+#define X(L) case L: Mont_Mult_sum_<L>(z, x, y, n, sx, sy); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    mp_limb_t tmp[MAX_MOD_SZ];
+    inline_mpn_zero(z, t);
+    for (size_t i = 0; i < n; i++)
+      {
+        Mont_Mult(tmp, x + i * sx, y + i * sy);
+        Add(z, z, tmp);
+      }
+  }
+}
+
 
 ostream& operator<<(ostream& s,const Zp_Data& ZpD)
 {
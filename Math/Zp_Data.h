@@ -51,6 +51,16 @@ class Zp_Data
   void Mont_Mult_max(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
       int max_t) const;
 
+  template <int T>
+  void Add_many_(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sz, size_t sx, size_t sy, bool sub) const;
+  template <int T>
+  void Mont_Mult_many_(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sz, size_t sx, size_t sy, bool add) const;
+  template <int T>
+  void Mont_Mult_sum_(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sx, size_t sy) const;
+
   public:
 
   bigint       pr;
@@ -89,6 +99,25 @@ class Zp_Data
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
 
+  /*
+   * Operations on n elements at strides in limbs. The output may
+   * alias an input element by element. These use AVX-512 (IFMA for
+   * products) if available.
+   */
+  void Add_many(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sz, size_t sx, size_t sy) const;
+  void Sub_many(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sz, size_t sx, size_t sy) const;
+  // Montgomery products, only y has to be reduced
+  void Mont_Mult_many(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sz, size_t sx, size_t sy) const;
+  // z += x * y in Montgomery representation
+  void Mont_Mult_add_many(mp_limb_t* z, const mp_limb_t* x,
+      const mp_limb_t* y, size_t n, size_t sz, size_t sx, size_t sy) const;
+  // sum of Montgomery products
+  void Mont_Mult_sum(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, size_t sx, size_t sy) const;
+
   bool operator!=(const Zp_Data& other) const;
   bool operator==(const Zp_Data& other) const;
 
@@ -136,15 +165,11 @@ inline void Zp_Data::Add<0>(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y
 template<>
 inline void Zp_Data::Add<1>(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const
 {
-#if defined(__clang__) || !defined(__x86_64__) || ((__GNUC__ >= 9) && (__GNUC__ <= 11)) || __GNUC__ == 14
-  Add<0>(ans, x, y);
-#else
-  *ans = *x + *y;
-  asm goto ("jc %l[sub]" :::: sub);
-  if (mpn_cmp(ans, prA, 1) >= 0)
- sub:
-      *ans -= *prA;
-#endif
+  // the carry flag cannot be relied upon after C code
+  mp_limb_t sum;
+  if (__builtin_add_overflow(*x, *y, &sum) or sum >= *prA)
+    sum -= *prA;
+  *ans = sum;
 }
 
 template<>
@@ -153,15 +178,12 @@ inline void Zp_Data::Add<2>(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y
 #if defined(__clang__) || !defined(__x86_64__) || (__GNUC__ == 9)
   Add<0>(ans, x, y);
 #else
-  __uint128_t a, b, p;
+  __uint128_t a, b, p, c;
   memcpy(&a, x, sizeof(__uint128_t));
   memcpy(&b, y, sizeof(__uint128_t));
   memcpy(&p, prA, sizeof(__uint128_t));
-  __uint128_t c = a + b;
-  asm goto ("jc %l[sub]" :::: sub);
-  if (c >= p)
- sub:
-      c -= p;
+  if (__builtin_add_overflow(a, b, &c) or c >= p)
+    c -= p;
   memcpy(ans, &c, sizeof(__uint128_t));
 #endif
 }
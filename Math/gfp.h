@@ -245,6 +245,35 @@ class gfp_ : public ValueInterface
    */
   void randomize(PRNG& G, int n = -1)
     { (void) n; a.randomize(G,ZpD); }
+  /**
+   * Sample several elements with uniform distribution
+   * in the same way as one by one.
+   */
+  static void randomize_many(PRNG& G, gfp_* res, size_t n)
+    {
+      static_assert(sizeof(gfp_) == L * sizeof(mp_limb_t), "wrong size");
+      G.randomBndBulk((mp_limb_t*) res, ZpD.get_prA(), ZpD.pr_byte_length,
+          n, L, ZpD.overhang_mask());
+    }
+  /**
+   * Element-wise operations on arrays with strides in elements,
+   * using AVX-512 if available. The output may alias an input
+   * element by element.
+   */
+  static void add_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+      size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1);
+  static void sub_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+      size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1);
+  static void mul_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+      size_t res_stride = 1, size_t x_stride = 1, size_t y_stride = 1);
+  /// ``res[i] += x[i] * y[i]``
+  static void mul_add_many(gfp_* res, const gfp_* x, const gfp_* y,
+      size_t n, size_t res_stride = 1, size_t x_stride = 1,
+      size_t y_stride = 1);
+  /// Sum of ``x[i] * y[i]``
+  static void dot_product(gfp_& res, const gfp_* x, const gfp_* y, size_t n,
+      size_t x_stride = 1, size_t y_stride = 1);
+
   // faster randomization, see implementation for explanation
   void almost_randomize(PRNG& G);
 
@@ -381,6 +410,62 @@ gfp_<X, L>::gfp_(PRNG& G) : gfp_()
   randomize(G);
 }
 
+template<int X, int L>
+void gfp_<X, L>::add_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+    size_t res_stride, size_t x_stride, size_t y_stride)
+{
+  if (ZpD.get_t() == L)
+    ZpD.Add_many((mp_limb_t*) res, (const mp_limb_t*) x, (const mp_limb_t*) y,
+        n, L * res_stride, L * x_stride, L * y_stride);
+  else
+    ValueInterface::add_many(res, x, y, n, res_stride, x_stride, y_stride);
+}
+
+template<int X, int L>
+void gfp_<X, L>::sub_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+    size_t res_stride, size_t x_stride, size_t y_stride)
+{
+  if (ZpD.get_t() == L)
+    ZpD.Sub_many((mp_limb_t*) res, (const mp_limb_t*) x, (const mp_limb_t*) y,
+        n, L * res_stride, L * x_stride, L * y_stride);
+  else
+    ValueInterface::sub_many(res, x, y, n, res_stride, x_stride, y_stride);
+}
+
+template<int X, int L>
+void gfp_<X, L>::mul_many(gfp_* res, const gfp_* x, const gfp_* y, size_t n,
+    size_t res_stride, size_t x_stride, size_t y_stride)
+{
+  if (ZpD.get_mont())
+    ZpD.Mont_Mult_many((mp_limb_t*) res, (const mp_limb_t*) x,
+        (const mp_limb_t*) y, n, L * res_stride, L * x_stride, L * y_stride);
+  else
+    ValueInterface::mul_many(res, x, y, n, res_stride, x_stride, y_stride);
+}
+
+template<int X, int L>
+void gfp_<X, L>::mul_add_many(gfp_* res, const gfp_* x, const gfp_* y,
+    size_t n, size_t res_stride, size_t x_stride, size_t y_stride)
+{
+  if (ZpD.get_mont())
+    ZpD.Mont_Mult_add_many((mp_limb_t*) res, (const mp_limb_t*) x,
+        (const mp_limb_t*) y, n, L * res_stride, L * x_stride, L * y_stride);
+  else
+    ValueInterface::mul_add_many(res, x, y, n, res_stride, x_stride,
+        y_stride);
+}
+
+template<int X, int L>
+void gfp_<X, L>::dot_product(gfp_& res, const gfp_* x, const gfp_* y,
+    size_t n, size_t x_stride, size_t y_stride)
+{
+  if (ZpD.get_mont())
+    ZpD.Mont_Mult_sum((mp_limb_t*) &res, (const mp_limb_t*) x,
+        (const mp_limb_t*) y, n, L * x_stride, L * y_stride);
+  else
+    ValueInterface::dot_product(res, x, y, n, x_stride, y_stride);
+}
+
 template <int X, int L>
 inline void gfp_<X, L>::zero_overhang()
 {
@@ -9,6 +9,7 @@
 #include "Tools/random.h"
 #include "Tools/BitVector.h"
 #include "Tools/intrinsics.h"
+#include "Tools/cpu_support.h"
 #include "Math/Square.h"
 
 union matrix16x8
@@ -154,8 +155,103 @@ const int perm[] = { 0, 8, 4, 0xc, 2, 0xa, 6, 0xe, 1, 9, 5, 0xd, 3, 0xb, 7, 0xf
 const int perm2[] = { 0, 4, 2, 6, 1, 5, 3, 7, 8, 0xc, 0xa, 0xe, 9, 0xd, 0xb, 0xf };
 #endif
 
-UNROLL_LOOPS
+#if defined(__GFNI__) and defined(__AVX512VBMI__)
+/*
+ * The square consists of 16x16 blocks of 8x8 bits. The first pass
+ * collects the blocks in 64-bit words per block column, the second
+ * transposes the blocks with a single affine transformation and
+ * writes eight output rows at once.
+ */
+class gfni_transposer
+{
+    __m512i gather[4], scatter[2];
+
+public:
+    static bool usable()
+    {
+        static bool res = cpu_has_gfni() and cpu_has_avx512vbmi();
+        return res;
+    }
+
+    gfni_transposer()
+    {
+        octet idx[64];
+        for (int o = 0; o < 4; o++)
+        {
+            // reverse rows within a block for the affine transformation
+            for (int p = 0; p < 64; p++)
+                idx[p] = (7 - (p & 7)) * 16 + 4 * o + p / 16;
+            gather[o] = _mm512_loadu_si512(idx);
+        }
+        for (int h = 0; h < 2; h++)
+        {
+            for (int p = 0; p < 64; p++)
+                idx[p] = (p % 16) * 8 + 4 * h + p / 16;
+            scatter[h] = _mm512_loadu_si512(idx);
+        }
+    }
+
+    UNROLL_LOOPS
+    void transpose(square128& square) const
+    {
+        octet columns[16][128] __attribute__((aligned (64)));
+        auto rows = (__m512i*) square.rows;
+
+        for (int g = 0; g < 8; g++)
+        {
+            __m512i in[4];
+            for (int i = 0; i < 4; i++)
+                in[i] = _mm512_loadu_si512(rows + 4 * g + i);
+            for (int o = 0; o < 4; o++)
+            {
+                auto upper = _mm512_permutex2var_epi8(in[0], gather[o], in[1]);
+                auto lower = _mm512_permutex2var_epi8(in[2], gather[o], in[3]);
+                auto x = _mm512_mask_blend_epi8(0xFF00FF00FF00FF00, upper, lower);
+                // lane k goes to column 4 * o + k
+                for (int k = 0; k < 4; k++)
+                    _mm512_mask_storeu_epi8(
+                            columns[4 * o + k] + 16 * (g - k),
+                            0xFFFFull << (16 * k), x);
+            }
+        }
+
+        auto affine = _mm512_set1_epi64(0x8040201008040201);
+        for (int c = 0; c < 16; c++)
+        {
+            auto in = (__m512i*) columns[c];
+            auto x = _mm512_gf2p8affine_epi64_epi8(affine, in[0], 0);
+            auto y = _mm512_gf2p8affine_epi64_epi8(affine, in[1], 0);
+            for (int h = 0; h < 2; h++)
+                _mm512_storeu_si512(rows + 2 * c + h,
+                        _mm512_permutex2var_epi8(x, scatter[h], y));
+        }
+    }
+};
+#endif
+
+void square128::transpose(square128* squares, size_t n_squares)
+{
+#if defined(__GFNI__) and defined(__AVX512VBMI__)
+    if (gfni_transposer::usable())
+    {
+        gfni_transposer transposer;
+        for (size_t i = 0; i < n_squares; i++)
+            transposer.transpose(squares[i]);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < n_squares; i++)
+        squares[i].transpose_unpack();
+}
+
 void square128::transpose()
+{
+    transpose(this, 1);
+}
+
+UNROLL_LOOPS
+void square128::transpose_unpack()
 {
 #ifdef USE_SUBSQUARES
     for (int j = 0; j < N_SUBSQUARES; j++)
@@ -451,8 +547,7 @@ void BitMatrix::resize(int length)
 
 void BitMatrix::transpose()
 {
-    for (size_t i = 0; i < squares.size(); i++)
-        squares[i].transpose();
+    square128::transpose(squares.data(), squares.size());
 }
 
 void BitMatrix::check_transpose(BitMatrix& dual)
@@ -487,6 +582,5 @@ void BitMatrix::vertical_to(vector<BitVector>& output)
 template <>
 void Slice<BitMatrix>::transpose()
 {
-    for (size_t i = start; i < end; i++)
-        bm.squares[i].transpose();
+    square128::transpose(&bm.squares[start], end - start);
 }
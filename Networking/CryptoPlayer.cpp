@@ -6,6 +6,7 @@
 #include "CryptoPlayer.h"
 #include "Math/Setup.h"
 #include "Tools/Bundle.h"
+#include "Processor/OnlineOptions.h"
 
 void check_ssl_file(string filename)
 {
@@ -56,16 +57,60 @@ CryptoPlayer::CryptoPlayer(const Names& Nms, const string& id_base) :
         MultiPlayer<ssl_socket*>(Nms, id_base),
         ctx("P" + to_string(my_num()))
 {
-    sockets.resize(num_players());
-    other_sockets.resize(num_players());
     senders.resize(num_players());
     receivers.resize(num_players());
 
+    setup_connections(Nms, id_base, sockets, other_sockets);
+
+    int n_stripes = OnlineOptions::singleton.n_stripes;
+    stripe_sockets.resize(n_stripes - 1);
+    stripe_other_sockets.resize(n_stripes - 1);
+    for (int k = 1; k < n_stripes; k++)
+        setup_connections(Nms, id_base + "S" + to_string(k),
+                stripe_sockets[k - 1], stripe_other_sockets[k - 1]);
+
+    stripe_senders.resize(n_stripes - 1,
+            vector<Sender<ssl_socket*>*>(num_players()));
+    stripe_receivers.resize(n_stripes - 1,
+            vector<Receiver<ssl_socket*>*>(num_players()));
+
+    for (int i = 0; i < num_players(); i++)
+    {
+        if (i == my_num())
+        {
+            senders[i] = 0;
+            receivers[i] = 0;
+            continue;
+        }
+
+        senders[i] = new Sender<ssl_socket*>(
+                i < my_num() ? sockets[i] : other_sockets[i], i);
+        receivers[i] = new Receiver<ssl_socket*>(
+                i < my_num() ? other_sockets[i] : sockets[i], i);
+
+        for (int k = 0; k < n_stripes - 1; k++)
+        {
+            auto& first = stripe_sockets[k];
+            auto& second = stripe_other_sockets[k];
+            stripe_senders[k][i] = new Sender<ssl_socket*>(
+                    i < my_num() ? first[i] : second[i], i);
+            stripe_receivers[k][i] = new Receiver<ssl_socket*>(
+                    i < my_num() ? second[i] : first[i], i);
+        }
+    }
+}
+
+void CryptoPlayer::setup_connections(const Names& Nms, const string& id,
+        vector<ssl_socket*>& first, vector<ssl_socket*>& second)
+{
+    first.resize(num_players());
+    second.resize(num_players());
+
     vector<int> plaintext_sockets[2];
 
     for (int i = 0; i < 2; i++)
     {
-        PlainPlayer player(Nms, id_base + (i ? "recv" : ""));
+        PlainPlayer player(Nms, id + (i ? "recv" : ""), 1);
         plaintext_sockets[i] = player.sockets;
         close_client_socket(player.socket(my_num()));
         player.sockets.clear();
@@ -78,35 +123,19 @@ CryptoPlayer::CryptoPlayer(const Names& Nms, const string& id_base) :
             swap(others[0], others[1]);
 
         if (num_players() % 2 == 0 and offset == num_players() / 2)
-            connect(others[0], plaintext_sockets);
+            connect(others[0], plaintext_sockets, first, second);
         else
             for (int i = 0; i < 2; i++)
-                connect(others[i], plaintext_sockets);
-    }
-
-    for (int i = 0; i < num_players(); i++)
-    {
-        if (i == my_num())
-        {
-            sockets[i] = 0;
-            senders[i] = 0;
-            other_sockets[i] = 0;
-            receivers[i] = 0;
-            continue;
-        }
-
-        senders[i] = new Sender<ssl_socket*>(
-                i < my_num() ? sockets[i] : other_sockets[i], i);
-        receivers[i] = new Receiver<ssl_socket*>(
-                i < my_num() ? other_sockets[i] : sockets[i], i);
+                connect(others[i], plaintext_sockets, first, second);
     }
 }
 
-void CryptoPlayer::connect(int i, vector<int>* plaintext_sockets)
+void CryptoPlayer::connect(int i, vector<int>* plaintext_sockets,
+        vector<ssl_socket*>& first, vector<ssl_socket*>& second)
 {
-    sockets[i] = new ssl_socket(io_service, ctx, plaintext_sockets[0][i],
+    first[i] = new ssl_socket(io_service, ctx, plaintext_sockets[0][i],
             "P" + to_string(i), "P" + to_string(my_num()), i < my_num());
-    other_sockets[i] = new ssl_socket(io_service, ctx, plaintext_sockets[1][i],
+    second[i] = new ssl_socket(io_service, ctx, plaintext_sockets[1][i],
             "P" + to_string(i), "P" + to_string(my_num()), i < my_num());
 
 }
@@ -118,33 +147,157 @@ CryptoPlayer::CryptoPlayer(const Names& Nms, int id_base) :
 
 CryptoPlayer::~CryptoPlayer()
 {
+    delete_senders();
+
     for (int i = 0; i < num_players(); i++)
     {
         delete sockets[i];
         delete other_sockets[i];
-        delete senders[i];
         delete receivers[i];
     }
+
+    for (size_t k = 0; k < stripe_sockets.size(); k++)
+        for (int i = 0; i < num_players(); i++)
+        {
+            delete stripe_senders[k][i];
+            delete stripe_receivers[k][i];
+            delete stripe_sockets[k][i];
+            delete stripe_other_sockets[k][i];
+        }
+}
+
+Sender<ssl_socket*>& CryptoPlayer::sender(int other, int stripe) const
+{
+    if (stripe == 0)
+        return *senders.at(other);
+    else
+        return *stripe_senders.at(stripe - 1).at(other);
+}
+
+Receiver<ssl_socket*>& CryptoPlayer::receiver(int other, int stripe) const
+{
+    if (stripe == 0)
+        return *receivers.at(other);
+    else
+        return *stripe_receivers.at(stripe - 1).at(other);
+}
+
+/*
+ * Without striping, messages go directly to the threads of the first
+ * connection. Otherwise, messages from PlainPlayer::STRIPE_THRESHOLD are
+ * split into one contiguous part per connection, and smaller ones only
+ * use the first connection. The first part starts with the number of
+ * parts, so the receiver only waits for further parts when necessary.
+ * The sending threads encrypt the parts in parallel.
+ */
+void CryptoPlayer::start_sending(int other, const octetStream& o) const
+{
+    if (stripe_senders.empty())
+        return senders[other]->request(o);
+
+    auto& parts = send_parts[{other, &o}];
+    assert(parts.empty());
+    size_t length = o.get_length();
+    int n_parts = length < PlainPlayer::STRIPE_THRESHOLD ?
+            1 : stripe_senders.size() + 1;
+    size_t part_size = DIV_CEIL(length, n_parts);
+    parts.resize(n_parts);
+    parts[0].store_int(n_parts, 1);
+    for (int k = 0; k < n_parts; k++)
+    {
+        size_t begin = min(length, k * part_size);
+        size_t end = min(length, (k + 1) * part_size);
+        parts[k].append(o.get_data() + begin, end - begin);
+        sender(other, k).request(parts[k]);
+    }
+}
+
+void CryptoPlayer::finish_sending(int other, const octetStream& o) const
+{
+    if (stripe_senders.empty())
+        return senders[other]->wait(o);
+
+    auto it = send_parts.find({other, &o});
+    assert(it != send_parts.end());
+    auto& parts = it->second;
+    for (size_t k = 0; k < parts.size(); k++)
+        sender(other, k).wait(parts[k]);
+    send_parts.erase(it);
+}
+
+void CryptoPlayer::start_receiving(int other, octetStream& o) const
+{
+    if (stripe_receivers.empty())
+        return receivers[other]->request(o);
+
+    auto& parts = receive_parts[{other, &o}];
+    assert(parts.empty());
+    parts.resize(1);
+    receiver(other, 0).request(parts[0]);
+}
+
+/*
+ * Further parts are requested in the order of finishing, which has to
+ * match the order of starting for the same player.
+ */
+void CryptoPlayer::finish_receiving(int other, octetStream& o) const
+{
+    if (stripe_receivers.empty())
+        return receivers[other]->wait(o);
+
+    auto it = receive_parts.find({other, &o});
+    assert(it != receive_parts.end());
+    auto& parts = it->second;
+    receiver(other, 0).wait(parts[0]);
+    size_t n_parts = parts[0].get_int(1);
+    if (n_parts < 1 or n_parts > stripe_receivers.size() + 1)
+        throw runtime_error("invalid number of message parts");
+    parts.resize(n_parts);
+    for (size_t k = 1; k < n_parts; k++)
+        receiver(other, k).request(parts[k]);
+
+    o.reset_write_head();
+    o.append(parts[0].get_data() + 1, parts[0].get_length() - 1);
+    for (size_t k = 1; k < n_parts; k++)
+    {
+        receiver(other, k).wait(parts[k]);
+        o.concat(parts[k]);
+    }
+    o.reset_read_head();
+    receive_parts.erase(it);
+}
+
+void CryptoPlayer::request_send_no_stats(int other, const octetStream& o) const
+{
+    assert(other != my_num());
+    start_sending(other, o);
+}
+
+void CryptoPlayer::wait_send_no_stats(int other, const octetStream& o) const
+{
+    assert(other != my_num());
+    finish_sending(other, o);
 }
 
 void CryptoPlayer::send_to_no_stats(int other, const octetStream& o) const
 {
     assert(other != my_num());
-    senders[other]->request(o);
-    senders[other]->wait(o);
+    start_sending(other, o);
+    finish_sending(other, o);
 }
 
 void CryptoPlayer::receive_player_no_stats(int other, octetStream& o) const
 {
     assert(other != my_num());
-    receivers[other]->request(o);
-    receivers[other]->wait(o);
+    start_receiving(other, o);
+    finish_receiving(other, o);
 }
 
 size_t CryptoPlayer::send_no_stats(int player, const PlayerBuffer& buffer,
         bool block) const
 {
     assert(player != my_num());
+    flush_sends(player);
     auto socket = senders.at(player)->get_socket();
     if (block)
     {
@@ -173,16 +326,21 @@ void CryptoPlayer::exchange_no_stats(int other, const octetStream& to_send,
         octetStream& to_receive) const
 {
     assert(other != my_num());
-    if (&to_send == &to_receive)
+    if (&to_send == &to_receive and not stripe_senders.empty())
+    {
+        octetStream copy = to_send;
+        exchange_no_stats(other, copy, to_receive);
+    }
+    else if (&to_send == &to_receive)
     {
         MultiPlayer<ssl_socket*>::exchange_no_stats(other, to_send, to_receive);
     }
     else
     {
-        senders[other]->request(to_send);
-        receivers[other]->request(to_receive);
-        senders[other]->wait(to_send);
-        receivers[other]->wait(to_receive);
+        start_sending(other, to_send);
+        start_receiving(other, to_receive);
+        finish_sending(other, to_send);
+        finish_receiving(other, to_receive);
     }
 }
 
@@ -190,7 +348,12 @@ void CryptoPlayer::pass_around_no_stats(const octetStream& to_send,
         octetStream& to_receive, int offset) const
 {
     assert(get_player(offset) != my_num());
-    if (&to_send == &to_receive)
+    if (&to_send == &to_receive and not stripe_senders.empty())
+    {
+        octetStream copy = to_send;
+        pass_around_no_stats(copy, to_receive, offset);
+    }
+    else if (&to_send == &to_receive)
     {
         MultiPlayer<ssl_socket*>::pass_around_no_stats(to_send, to_receive, offset);
     }
@@ -200,10 +363,10 @@ void CryptoPlayer::pass_around_no_stats(const octetStream& to_send,
         Timer recv_timer;
         TimeScope ts(recv_timer);
 #endif
-        senders[get_player(offset)]->request(to_send);
-        receivers[get_player(-offset)]->request(to_receive);
-        senders[get_player(offset)]->wait(to_send);
-        receivers[get_player(-offset)]->wait(to_receive);
+        start_sending(get_player(offset), to_send);
+        start_receiving(get_player(-offset), to_receive);
+        finish_sending(get_player(offset), to_send);
+        finish_receiving(get_player(-offset), to_receive);
 #ifdef TIME_ROUNDS
         cout << "Exchange time: " << recv_timer.elapsed() << " seconds to receive "
             << 1e-3 * to_receive.get_length() << " KB" << endl;
@@ -221,18 +384,18 @@ void CryptoPlayer::send_receive_all_no_stats(const vector<vector<bool>>& channel
         int other = get_player(offset);
         bool receive = channels[other][my_num()];
         if (channels[my_num()][other])
-            this->senders[other]->request(to_send[other]);
+            start_sending(other, to_send[other]);
         if (receive)
-            this->receivers[other]->request(to_receive[other]);
+            start_receiving(other, to_receive[other]);
     }
     for (int offset = 1; offset < num_players(); offset++)
     {
         int other = get_player(offset);
         bool receive = channels[other][my_num()];
         if (channels[my_num()][other])
-            this->senders[other]->wait(to_send[other]);
+            finish_sending(other, to_send[other]);
         if (receive)
-            this->receivers[other]->wait(to_receive[other]);
+            finish_receiving(other, to_receive[other]);
     }
 }
 
@@ -247,20 +410,23 @@ void CryptoPlayer::partial_broadcast(const vector<bool>& my_senders,
         bool receive = my_senders.at(other);
         if (my_receivers.at(other))
         {
-            this->senders[other]->request(os[my_num()]);
+            start_sending(other, os[my_num()]);
             sent += os[my_num()].get_length();
         }
         if (receive)
-            this->receivers[other]->request(os[other]);
+            start_receiving(other, os[other]);
     }
     for (int offset = 1; offset < num_players(); offset++)
     {
         int other = get_player(offset);
         bool receive = my_senders[other];
         if (my_receivers[other])
-            this->senders[other]->wait(os[my_num()]);
+            finish_sending(other, os[my_num()]);
         if (receive)
-            this->receivers[other]->wait(os[other]);
+        {
+            finish_receiving(other, os[other]);
+            comm_stats.received += os[other].get_length();
+        }
     }
 }
 
@@ -269,14 +435,14 @@ void CryptoPlayer::Broadcast_Receive_no_stats(vector<octetStream>& os) const
     for (int offset = 1; offset < num_players(); offset++)
     {
         int other = get_player(offset);
-        this->senders[other]->request(os[my_num()]);
-        receivers[other]->request(os[other]);
+        start_sending(other, os[my_num()]);
+        start_receiving(other, os[other]);
     }
 
     for (int offset = 1; offset < num_players(); offset++)
     {
         int other = get_player(offset);
-        this->senders[other]->wait(os[my_num()]);
-        receivers[other]->wait(os[other]);
+        finish_sending(other, os[my_num()]);
+        finish_receiving(other, os[other]);
     }
 }
@@ -12,6 +12,8 @@
 #include <boost/asio/ssl.hpp>
 #include <boost/asio.hpp>
 
+#include <map>
+
 /**
  * Encrypted multi-party communication.
  * Uses OpenSSL and certificates issued to "P<player_no>".
@@ -25,14 +27,36 @@ class CryptoPlayer : public MultiPlayer<ssl_socket*>
 
     vector<ssl_socket*> other_sockets;
 
-    vector<Sender<ssl_socket*>*> senders;
     vector<Receiver<ssl_socket*>*> receivers;
 
-    void connect(int other, vector<int>* plaintext_sockets);
+    // further connections by stripe and player
+    vector<vector<ssl_socket*>> stripe_sockets, stripe_other_sockets;
+    vector<vector<Sender<ssl_socket*>*>> stripe_senders;
+    vector<vector<Receiver<ssl_socket*>*>> stripe_receivers;
+
+    // parts of messages in flight when striping
+    mutable map<pair<int, const octetStream*>, vector<octetStream>> send_parts;
+    mutable map<pair<int, octetStream*>, vector<octetStream>> receive_parts;
+
+    void setup_connections(const Names& Nms, const string& id,
+            vector<ssl_socket*>& first, vector<ssl_socket*>& second);
+    void connect(int other, vector<int>* plaintext_sockets,
+            vector<ssl_socket*>& first, vector<ssl_socket*>& second);
+
+    Sender<ssl_socket*>& sender(int other, int stripe) const;
+    Receiver<ssl_socket*>& receiver(int other, int stripe) const;
+
+    // split large messages into one message per stripe if striping
+    void start_sending(int other, const octetStream& o) const;
+    void finish_sending(int other, const octetStream& o) const;
+    void start_receiving(int other, octetStream& o) const;
+    void finish_receiving(int other, octetStream& o) const;
 
 public:
     /**
      * Start a new set of encrypted connections.
+     * With ``--stripes``, large messages are split across several
+     * connections, which are encrypted in parallel.
      * @param Nms network setup
      * @param id unique identifier
      */
@@ -46,6 +70,10 @@ public:
     void send_to_no_stats(int other, const octetStream& o) const;
     void receive_player_no_stats(int other, octetStream& o) const;
 
+    void request_send_no_stats(int other, const octetStream& o) const;
+    void wait_send_no_stats(int other, const octetStream& o) const;
+
+    // raw buffers only use the first connection
     size_t send_no_stats(int player, const PlayerBuffer& buffer,
             bool block) const;
     size_t recv_no_stats(int player, const PlayerBuffer& buffer,
@@ -11,6 +11,8 @@
 
 #include <sys/select.h>
 #include <utility>
+#include <thread>
+#include <exception>
 #include <assert.h>
 
 using namespace std;
@@ -242,10 +244,19 @@ MultiPlayer<T>::MultiPlayer(const Names& Nms, const string& id) :
 
 
 PlainPlayer::PlainPlayer(const Names& Nms, const string& id) :
+        PlainPlayer(Nms, id, OnlineOptions::singleton.n_stripes)
+{
+}
+
+
+PlainPlayer::PlainPlayer(const Names& Nms, const string& id, int n_stripes) :
         MultiPlayer<int>(Nms, id)
 {
   if (Nms.num_players() > 1)
-    setup_sockets(Nms.names, Nms.ports, id, *Nms.server);
+    {
+      setup_sockets(Nms.names, Nms.ports, id, *Nms.server);
+      setup_stripes(Nms, id, n_stripes);
+    }
 }
 
 
@@ -256,18 +267,74 @@ PlainPlayer::PlainPlayer(const Names& Nms, int id_base) :
 
 PlainPlayer::~PlainPlayer()
 {
+  delete_senders();
+
   if (num_players() > 1)
     {
       /* Close down the sockets */
       for (auto socket : sockets)
         close_client_socket(socket);
       close_client_socket(send_to_self_socket);
+      for (auto& stripe : stripes)
+        for (int i = 0; i < num_players(); i++)
+          if (i != my_num())
+            close_client_socket(stripe[i]);
     }
 }
 
 template<class T>
 MultiPlayer<T>::~MultiPlayer()
 {
+  delete_senders();
+}
+
+template<class T>
+void MultiPlayer<T>::delete_senders()
+{
+  for (auto& sender : senders)
+    {
+      delete sender;
+      sender = 0;
+    }
+}
+
+template<class T>
+Sender<T>& MultiPlayer<T>::get_sender(int player) const
+{
+  senders.resize(num_players());
+  auto& sender = senders.at(player);
+  if (not sender)
+    sender = new Sender<T>(socket_to_send(player), player);
+  return *sender;
+}
+
+template<class T>
+void MultiPlayer<T>::flush_sends(int player) const
+{
+  if (size_t(player) < senders.size() and senders[player])
+    senders[player]->flush();
+}
+
+template<class T>
+void MultiPlayer<T>::flush_sends() const
+{
+  for (auto sender : senders)
+    if (sender)
+      sender->flush();
+}
+
+template<class T>
+void MultiPlayer<T>::request_send_no_stats(int player,
+    const octetStream& o) const
+{
+  get_sender(player).request(o);
+}
+
+template<class T>
+void MultiPlayer<T>::wait_send_no_stats(int player,
+    const octetStream& o) const
+{
+  get_sender(player).wait(o);
 }
 
 Player::~Player()
@@ -346,11 +413,192 @@ void PlainPlayer::setup_sockets(const vector<string>& names,
     }
 }
 
+void PlainPlayer::setup_stripes(const Names& Nms, const string& id,
+    int n_stripes)
+{
+  for (int k = 1; k < n_stripes; k++)
+    {
+      PlainPlayer player(Nms, id + "S" + to_string(k), 1);
+      stripes.push_back(player.sockets);
+      close_client_socket(player.socket(my_num()));
+      player.sockets.clear();
+    }
+}
+
+/*
+ * The length is sent first on the main connection as in
+ * octetStream::Send(). Messages below STRIPE_THRESHOLD follow on the
+ * main connection, which keeps them compatible with unstriped
+ * communication. Larger messages are split into one contiguous part per
+ * connection, and all parts are sent and received in parallel.
+ */
+void PlainPlayer::striped_exchange(int send_to, const octetStream* to_send,
+    int receive_from, octetStream* to_receive) const
+{
+  octetStream copy;
+  if (to_send and to_send == to_receive)
+    {
+      copy = *to_send;
+      to_send = &copy;
+    }
+
+  size_t send_len = 0, receive_len = 0;
+  octet* send_data = 0;
+  octet* receive_data = 0;
+  if (to_send)
+    {
+      flush_sends(send_to);
+      send_len = to_send->get_length();
+      send_data = to_send->get_data();
+      send(sockets[send_to], send_len, LENGTH_SIZE);
+    }
+  if (to_receive)
+    {
+      receive(sockets[receive_from], receive_len, LENGTH_SIZE);
+      to_receive->reset_write_head();
+      receive_data = to_receive->append(receive_len);
+    }
+
+  int n_stripes = stripes.size() + 1;
+  int n_send_parts = send_len < STRIPE_THRESHOLD ? 1 : n_stripes;
+  int n_receive_parts = receive_len < STRIPE_THRESHOLD ? 1 : n_stripes;
+  size_t send_part = DIV_CEIL(send_len, n_send_parts);
+  size_t receive_part = DIV_CEIL(receive_len, n_receive_parts);
+
+  auto run = [&](int k)
+    {
+      size_t sent = 0, send_end = 0, received = 0, receive_end = 0;
+      int send_socket = -1, receive_socket = -1;
+      if (k < n_send_parts)
+        {
+          sent = min(send_len, k * send_part);
+          send_end = min(send_len, (k + 1) * send_part);
+          send_socket = k ? stripes[k - 1][send_to] : sockets[send_to];
+        }
+      if (k < n_receive_parts)
+        {
+          received = min(receive_len, k * receive_part);
+          receive_end = min(receive_len, (k + 1) * receive_part);
+          receive_socket =
+              k ? stripes[k - 1][receive_from] : sockets[receive_from];
+        }
+
+      while (sent < send_end)
+        {
+          sent += send_non_blocking(send_socket, send_data + sent,
+              send_end - sent);
+          if (received < receive_end)
+            received += receive_non_blocking(receive_socket,
+                receive_data + received, receive_end - received);
+        }
+      if (received < receive_end)
+        receive(receive_socket, receive_data + received,
+            receive_end - received);
+    };
+
+  int n_parts = max(n_send_parts, n_receive_parts);
+  vector<exception_ptr> errors(n_parts);
+  vector<thread> threads;
+  for (int k = 1; k < n_parts; k++)
+    threads.push_back(thread([&, k]() {
+      try
+      {
+        run(k);
+      }
+      catch (...)
+      {
+        errors[k] = current_exception();
+      }
+    }));
+
+  try
+  {
+    run(0);
+  }
+  catch (...)
+  {
+    errors[0] = current_exception();
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+  for (auto& e : errors)
+    if (e)
+      rethrow_exception(e);
+
+  if (to_receive)
+    to_receive->reset_read_head();
+}
+
+void PlainPlayer::send_to_no_stats(int player, const octetStream& o) const
+{
+  if (use_stripes(player))
+    striped_exchange(player, &o, -1, 0);
+  else
+    MultiPlayer<int>::send_to_no_stats(player, o);
+}
+
+void PlainPlayer::receive_player_no_stats(int i, octetStream& o) const
+{
+  if (use_stripes(i))
+    striped_exchange(-1, 0, i, &o);
+  else
+    MultiPlayer<int>::receive_player_no_stats(i, o);
+}
+
+void PlainPlayer::request_send_no_stats(int player, const octetStream& o) const
+{
+  if (use_stripes(player))
+    send_to_no_stats(player, o);
+  else
+    MultiPlayer<int>::request_send_no_stats(player, o);
+}
+
+void PlainPlayer::wait_send_no_stats(int player, const octetStream& o) const
+{
+  if (not use_stripes(player))
+    MultiPlayer<int>::wait_send_no_stats(player, o);
+}
+
+void PlainPlayer::exchange_no_stats(int other, const octetStream& to_send,
+    octetStream& to_receive) const
+{
+  if (use_stripes(other))
+    striped_exchange(other, &to_send, other, &to_receive);
+  else
+    MultiPlayer<int>::exchange_no_stats(other, to_send, to_receive);
+}
+
+void PlainPlayer::pass_around_no_stats(const octetStream& to_send,
+    octetStream& to_receive, int offset) const
+{
+  if (use_stripes(get_player(offset)))
+    striped_exchange(get_player(offset), &to_send, get_player(-offset),
+        &to_receive);
+  else
+    MultiPlayer<int>::pass_around_no_stats(to_send, to_receive, offset);
+}
+
+void PlainPlayer::Broadcast_Receive_no_stats(vector<octetStream>& o) const
+{
+  if (stripes.empty())
+    return MultiPlayer<int>::Broadcast_Receive_no_stats(o);
+
+  if (o.size() != sockets.size())
+    throw runtime_error("player numbers don't match");
+
+  // all parties use the same offset at the same time
+  for (int offset = 1; offset < num_players(); offset++)
+    striped_exchange(get_player(offset), &o[my_num()], get_player(-offset),
+        &o[get_player(-offset)]);
+}
+
 
 template<class T>
 void MultiPlayer<T>::send_long(int i, long a) const
 {
   TimeScope ts(comm_stats["Sending by number"].add(sizeof(long)));
+  flush_sends(i);
   send(sockets[i], (octet*)&a, sizeof(long));
   sent += sizeof(long);
 }
@@ -378,11 +626,40 @@ void Player::send_to(int player,const octetStream& o) const
 template<class T>
 void MultiPlayer<T>::send_to_no_stats(int player,const octetStream& o) const
 {
+  flush_sends(player);
   T socket = socket_to_send(player);
   o.Send(socket);
 }
 
 
+void Player::request_send(int player, const octetStream& o) const
+{
+  TimeScope ts(comm_stats["Sending asynchronously"].add(o));
+  request_send_no_stats(player, o);
+  sent += o.get_length();
+}
+
+void Player::wait_send(int player, const octetStream& o) const
+{
+  // only account for the time
+  TimeScope ts(comm_stats["Sending asynchronously"].add_length_only(0));
+  wait_send_no_stats(player, o);
+}
+
+void Player::request_send_all(const octetStream& o) const
+{
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num())
+      request_send(i, o);
+}
+
+void Player::wait_send_all(const octetStream& o) const
+{
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num())
+      wait_send(i, o);
+}
+
 void Player::send_all(const octetStream& o) const
 {
   TimeScope ts(comm_stats["Sending to all"].add(o));
@@ -411,6 +688,7 @@ void Player::receive_player(int i,octetStream& o) const
   TimeScope ts(timer);
   receive_player_no_stats(i, o);
   comm_stats["Receiving directly"].add(o, ts);
+  comm_stats.received += o.get_length();
 }
 
 template<class T>
@@ -430,6 +708,7 @@ void Player::receive_player(int i, FlexBuffer& buffer) const
 size_t PlainPlayer::send_no_stats(int player,
         const PlayerBuffer& buffer, bool block) const
 {
+  flush_sends(player);
   if (block)
     {
       send(socket(player), buffer.data, buffer.size);
@@ -479,6 +758,7 @@ void Player::receive_relative(int offset, octetStream& o) const
 template<class T>
 void MultiPlayer<T>::exchange_no_stats(int other, const octetStream& o, octetStream& to_receive) const
 {
+  flush_sends(other);
   o.exchange(sockets[other], sockets[other], to_receive);
 }
 
@@ -490,6 +770,7 @@ void Player::exchange(int other, const octetStream& o, octetStream& to_receive)
   TimeScope ts(comm_stats["Exchanging"].add(o));
   exchange_no_stats(other, o, to_receive);
   sent += o.get_length();
+  comm_stats.received += to_receive.get_length();
 }
 
 
@@ -507,6 +788,7 @@ void Player::exchange_relative(int offset, octetStream& o) const
 template<class T>
 void MultiPlayer<T>::pass_around_no_stats(const octetStream& o, octetStream& to_receive, int offset) const
 {
+  flush_sends(get_player(offset));
   o.exchange(sockets.at(get_player(offset)), sockets.at(get_player(-offset)), to_receive);
 }
 
@@ -515,6 +797,7 @@ void Player::pass_around(octetStream& o, octetStream& to_receive, int offset) co
   TimeScope ts(comm_stats["Passing around"].add(o));
   pass_around_no_stats(o, to_receive, offset);
   sent += o.get_length();
+  comm_stats.received += to_receive.get_length();
 }
 
 
@@ -527,6 +810,8 @@ void MultiPlayer<T>::Broadcast_Receive_no_stats(vector<octetStream>& o) const
   if (o.size() != sockets.size())
     throw runtime_error("player numbers don't match");
 
+  flush_sends();
+
   vector<Exchanger<T>> exchangers;
   for (int i=1; i<nplayers; i++)
     {
@@ -549,6 +834,9 @@ void Player::unchecked_broadcast(vector<octetStream>& o) const
   TimeScope ts(comm_stats["Broadcasting"].add(o[player_no]));
   Broadcast_Receive_no_stats(o);
   sent += o[player_no].get_length() * (num_players() - 1);
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num())
+      comm_stats.received += o[i].get_length();
 }
 
 void Player::Broadcast_Receive(vector<octetStream>& o) const
@@ -610,6 +898,9 @@ void Player::send_receive_all(const vector<vector<bool>>& channels,
   TimeScope ts(comm_stats["Sending/receiving"].add(data));
   sent += data;
   send_receive_all_no_stats(channels, to_send, to_receive);
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num() and channels.at(i).at(my_num()))
+      comm_stats.received += to_receive.at(i).get_length();
 }
 
 void Player::partial_broadcast(const vector<bool>&,
@@ -643,7 +934,7 @@ void MultiPlayer<T>::send_receive_all_no_stats(
 
 
 ThreadPlayer::ThreadPlayer(const Names& Nms, const string& id_base) :
-    PlainPlayer(Nms, id_base)
+    PlainPlayer(Nms, id_base, 1)
 {
   for (int i = 0; i < Nms.num_players(); i++)
     {
@@ -665,8 +956,9 @@ ThreadPlayer::~ThreadPlayer()
     {
       if (senders[i]->timer.elapsed() > 0)
         cerr << "Waiting for sending to " << i << ": " << senders[i]->timer.elapsed() << endl;
-      delete senders[i];
     }
+
+  delete_senders();
 }
 
 void ThreadPlayer::request_receive(int i, octetStream& o) const
@@ -725,6 +1017,7 @@ void VirtualTwoPartyPlayer::receive(octetStream& o) const
   TimeScope ts(timer);
   P.receive_player_no_stats(other_player, o);
   comm_stats["Receiving one-to-one"].add(o, ts);
+  comm_stats.received += o.get_length();
 }
 
 void VirtualTwoPartyPlayer::send_receive_player(vector<octetStream>& o) const
@@ -732,6 +1025,7 @@ void VirtualTwoPartyPlayer::send_receive_player(vector<octetStream>& o) const
   TimeScope ts(comm_stats["Exchanging one-to-one"].add(o[0]));
   comm_stats.sent += o[0].get_length();
   P.exchange_no_stats(other_player, o[0], o[1]);
+  comm_stats.received += o[1].get_length();
 }
 
 VirtualTwoPartyPlayer::VirtualTwoPartyPlayer(Player& P, int other_player) :
@@ -755,6 +1049,7 @@ size_t VirtualTwoPartyPlayer::recv(const PlayerBuffer& buffer, bool block) const
   auto received = P.recv_no_stats(other_player, buffer, block);
   lock.lock();
   comm_stats.add_to_last_round("Receiving one-to-one", received);
+  comm_stats.received += received;
   lock.unlock();
   return received;
 }
@@ -772,7 +1067,7 @@ void TwoPartyPlayer::Broadcast_Receive(vector<octetStream>& o) const
   o[1 - my_num()] = os[1];
 }
 
-NamedCommStats::NamedCommStats() : sent(0)
+NamedCommStats::NamedCommStats() : sent(0), received(0)
 {
 }
 
@@ -787,6 +1082,7 @@ CommStats& CommStats::operator +=(const CommStats& other)
 NamedCommStats& NamedCommStats::operator +=(const NamedCommStats& other)
 {
   sent += other.sent;
+  received += other.received;
   for (auto it = other.begin(); it != other.end(); it++)
     map<string, CommStats>::operator[](it->first) += it->second;
   return *this;
@@ -811,6 +1107,7 @@ NamedCommStats NamedCommStats::operator -(const NamedCommStats& other) const
 {
   NamedCommStats res = *this;
   res.sent = sent - other.sent;
+  res.received = received - other.received;
   for (auto it = other.begin(); it != other.end(); it++)
     res.map<string, CommStats>::operator[](it->first) -= it->second;
   return res;
@@ -827,6 +1124,7 @@ CommStats& CommStats::imax(const CommStats& other)
 NamedCommStats& NamedCommStats::imax(const NamedCommStats& other)
 {
   sent = max(sent, other.sent);
+  received = max(received, other.received);
   for (auto it = other.begin(); it != other.end(); it++)
     map<string, CommStats>::operator[](it->first).imax(it->second);
   return *this;
@@ -859,6 +1157,7 @@ void NamedCommStats::reset()
 {
   clear();
   sent = 0;
+  received = 0;
 }
 
 Timer& NamedCommStats::add_to_last_round(const string& name, size_t length)
@@ -872,6 +1171,14 @@ Timer& NamedCommStats::add_to_last_round(const string& name, size_t length)
     }
 }
 
+size_t NamedCommStats::total_rounds() const
+{
+  size_t res = 0;
+  for (auto& x : *this)
+    res += x.second.rounds;
+  return res;
+}
+
 Timer& CommStatsWithName::add_length_only(size_t length)
 {
   if (OnlineOptions::singleton.has_option("verbose_comm"))
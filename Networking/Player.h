@@ -170,7 +170,7 @@ class NamedCommStats : public map<string, CommStats>
   using super = map<string, CommStats>;
 
 public:
-  size_t sent;
+  size_t sent, received;
   string last;
 
   NamedCommStats();
@@ -182,6 +182,7 @@ public:
   void print(bool newline = false, const NamedCommStats& max = {});
   void reset();
   Timer& add_to_last_round(const string& name, size_t length);
+  size_t total_rounds() const;
   CommStatsWithName operator[](const string& name)
   { return {name, map<string, CommStats>::operator[](name)}; }
 };
@@ -206,6 +207,8 @@ public:
   PlayerBase(int player_no) : player_no(player_no), sent(comm_stats.sent) {}
   virtual ~PlayerBase();
 
+  const NamedCommStats& get_comm_stats() const { return comm_stats; }
+
   int my_real_num() const { return player_no; }
   virtual int my_num() const = 0;
   virtual int num_players() const = 0;
@@ -398,6 +401,27 @@ public:
       const vector<bool>& receivers,
       vector<octetStream>& os) const;
 
+  /**
+   * Start sending to a specific player without blocking.
+   * ``o`` must not be changed before calling ``wait_send()``.
+   * Sending to the same player in the meantime is permitted.
+   */
+  void request_send(int player, const octetStream& o) const;
+  /**
+   * Wait for sending started by ``request_send()``.
+   */
+  void wait_send(int player, const octetStream& o) const;
+  /**
+   * Start sending the same to all other players without blocking.
+   */
+  void request_send_all(const octetStream& o) const;
+  void wait_send_all(const octetStream& o) const;
+
+  // blocking by default
+  virtual void request_send_no_stats(int player, const octetStream& o) const
+  { send_to_no_stats(player, o); }
+  virtual void wait_send_no_stats(int, const octetStream&) const {}
+
   // dummy functions for compatibility
   virtual void request_receive(int i, octetStream& o) const { (void)i; (void)o; }
   virtual void wait_receive(int i, octetStream& o) const
@@ -421,9 +445,18 @@ protected:
   vector<T> sockets;
   T send_to_self_socket;
 
+  // one thread per player for asynchronous sending, started when needed
+  mutable vector<Sender<T>*> senders;
+
   T socket_to_send(int player) const { return player == player_no ? send_to_self_socket : sockets[player]; }
   T socket(int i) const { return sockets[i]; }
 
+  Sender<T>& get_sender(int player) const;
+  // finish asynchronous sending before using a socket directly
+  void flush_sends(int player) const;
+  void flush_sends() const;
+  void delete_senders();
+
   friend class CryptoPlayer;
 
 public:
@@ -442,6 +475,9 @@ public:
   virtual void send_to_no_stats(int player,const octetStream& o) const;
   virtual void receive_player_no_stats(int i,octetStream& o) const;
 
+  virtual void request_send_no_stats(int player, const octetStream& o) const;
+  virtual void wait_send_no_stats(int player, const octetStream& o) const;
+
   // exchange data with minimal memory usage
   virtual void exchange_no_stats(int other, const octetStream& to_send,
       octetStream& to_receive) const;
@@ -465,22 +501,58 @@ public:
  */
 class PlainPlayer : public MultiPlayer<int>
 {
+  // further connections to every player by stripe
+  vector<vector<int>> stripes;
+
   void setup_sockets(const vector<string>& names, const vector<int>& ports,
       const string& id_base, ServerSocket& server);
+  void setup_stripes(const Names& Nms, const string& id, int n_stripes);
+
+  // null pointers for only sending or only receiving
+  void striped_exchange(int send_to, const octetStream* to_send,
+      int receive_from, octetStream* to_receive) const;
+
+  bool use_stripes(int player) const
+  { return not stripes.empty() and player != my_num(); }
 
 public:
+  // messages from this size are split across all stripes
+  static const size_t STRIPE_THRESHOLD = 1 << 20;
+
   /**
    * Start a new set of unencrypted connections.
    * @param Nms network setup
    * @param id unique identifier
    */
   PlainPlayer(const Names& Nms, const string& id);
+  /**
+   * Start a new set of unencrypted connections
+   * with ``n_stripes`` connections per pair of players.
+   * Large messages are split across all of them.
+   * @param Nms network setup
+   * @param id unique identifier
+   * @param n_stripes number of connections per pair of players
+   */
+  PlainPlayer(const Names& Nms, const string& id, int n_stripes);
   // legacy interface
   PlainPlayer(const Names& Nms, int id_base = 0);
   ~PlainPlayer();
 
   size_t send_no_stats(int player, const PlayerBuffer& buffer, bool block) const;
   size_t recv_no_stats(int player, const PlayerBuffer& buffer, bool block) const;
+
+  void send_to_no_stats(int player, const octetStream& o) const;
+  void receive_player_no_stats(int i, octetStream& o) const;
+
+  // sending is blocking when striping
+  void request_send_no_stats(int player, const octetStream& o) const;
+  void wait_send_no_stats(int player, const octetStream& o) const;
+
+  void exchange_no_stats(int other, const octetStream& to_send,
+      octetStream& to_receive) const;
+  void pass_around_no_stats(const octetStream& to_send,
+      octetStream& to_receive, int offset) const;
+  void Broadcast_Receive_no_stats(vector<octetStream>& o) const;
 };
 
 
@@ -488,7 +560,6 @@ class ThreadPlayer : public PlainPlayer
 {
 public:
   mutable vector<Receiver<int>*> receivers;
-  mutable vector<Sender<int>*>   senders;
 
   ThreadPlayer(const Names& Nms, const string& id_base);
   virtual ~ThreadPlayer();
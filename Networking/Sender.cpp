@@ -18,7 +18,7 @@ void* Sender<T>::run_thread(void* sender)
 
 template<class T>
 Sender<T>::Sender(T socket, int other) :
-        CommunicationThread(other), socket(socket), thread(0)
+        CommunicationThread(other), socket(socket), thread(0), n_pending(0)
 {
     start();
 }
@@ -66,16 +66,44 @@ void Sender<T>::run_with_error()
 template<class T>
 void Sender<T>::request(const octetStream& os)
 {
+    n_pending++;
     in.push(&os);
 }
 
 template<class T>
 void Sender<T>::wait(const octetStream& os)
 {
+    // requests are processed in order but might be waited for in any order
+    for (auto it = done.begin(); it != done.end(); it++)
+        if (*it == &os)
+        {
+            done.erase(it);
+            return;
+        }
+
     const octetStream* queued = 0;
-    out.pop(queued);
-    if (queued != &os)
-      throw not_implemented();
+    while (n_pending > 0)
+    {
+        out.pop(queued);
+        n_pending--;
+        if (queued == &os)
+            return;
+        done.push_back(queued);
+    }
+
+    throw runtime_error("waiting for sending that wasn't requested");
+}
+
+template<class T>
+void Sender<T>::flush()
+{
+    const octetStream* queued = 0;
+    while (n_pending > 0)
+    {
+        out.pop(queued);
+        n_pending--;
+        done.push_back(queued);
+    }
 }
 
 template class Sender<int>;
@@ -22,6 +22,10 @@ class Sender : CommunicationThread
     WaitQueue<const octetStream*> out;
     pthread_t thread;
 
+    // finished while waiting for another request
+    vector<const octetStream*> done;
+    size_t n_pending;
+
     static void* run_thread(void* sender);
 
     // prevent copying
@@ -44,6 +48,8 @@ public:
 
     void request(const octetStream& os);
     void wait(const octetStream& os);
+    // wait for all requests
+    void flush();
 };
 
 #endif /* NETWORKING_SENDER_H_ */
@@ -65,6 +65,9 @@ union square128 {
     void randomize(int row, PRNG& G);
     void conditional_add(BitVector& conditions, square128& other, int offset);
     void transpose();
+    void transpose_unpack();
+    // several squares with the same kernel
+    static void transpose(square128* squares, size_t n_squares);
     template <class T>
     void to(T& result);
 
@@ -39,6 +39,9 @@ public:
     virtual ~GeneratorThread() {};
     virtual void generate() = 0;
 
+    // by this party in all threads of the generator
+    virtual size_t data_sent() { return 0; }
+
     void lock();
     void unlock();
     void signal();
@@ -125,6 +128,8 @@ public:
     mac_key_type get_mac_key() const { return mac_key; }
 
     Player& get_player() { return globalPlayer; }
+
+    size_t data_sent() { return globalPlayer.total_comm().sent; }
 };
 
 template<class T>
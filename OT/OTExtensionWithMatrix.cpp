@@ -6,6 +6,7 @@
 #include "OTExtensionWithMatrix.h"
 #include "Tools/Bundle.h"
 #include "Tools/CodeLocations.h"
+#include "Tools/int.h"
 
 #ifndef USE_KOS
 #include "Networking/PlayerCtSocket.h"
@@ -63,13 +64,26 @@ bool OTExtensionWithMatrix::use_kos()
 #endif
 }
 
+bool OTExtensionWithMatrix::use_silent()
+{
+    return OnlineOptions::singleton.has_option("silent_ot");
+}
+
 void OTExtensionWithMatrix::protocol_agreement()
 {
     if (agreed)
         return;
 
+    if (use_silent() and not passive_only)
+    {
+        cerr << "Silent OT only provides passive security" << endl;
+        exit(1);
+    }
+
     Bundle<octetStream> bundle(*player);
-    if (use_kos())
+    if (use_silent())
+        bundle.mine = string("SilentOT");
+    else if (use_kos())
         bundle.mine = string("KOS15");
     else
         bundle.mine = string("SoftSpokenOT");
@@ -89,7 +103,7 @@ void OTExtensionWithMatrix::protocol_agreement()
     catch (mismatch_among_parties&)
     {
         cerr << "Parties compiled with different OT extensions" << endl;
-        cerr << "Set \"USE_KOS\" to the same value on all parties" << endl;
+        cerr << "Set \"USE_KOS\" and the options to the same value on all parties" << endl;
         cerr << "and make sure that the SoftSpokenOT parameter is the same" << endl;
         exit(1);
     }
@@ -133,14 +147,20 @@ void OTExtensionWithMatrix::extend(int nOTs_requested,
     CODE_LOCATION
     protocol_agreement();
 
-    if (use_kos())
+    if (use_silent())
     {
-        extend_correlated(nOTs_requested, newReceiverInput);
+        silent_extend(nOTs_requested, newReceiverInput);
         if (hash)
             hash_outputs(nOTs_requested);
         return;
     }
 
+    if (use_kos())
+    {
+        extend_correlated(nOTs_requested, newReceiverInput, hash);
+        return;
+    }
+
 #ifdef USE_KOS
     assert(use_kos());
 #else
@@ -244,12 +264,151 @@ void OTExtensionWithMatrix::soft_receiver(size_t n,
 }
 #endif
 
+void OTExtensionWithMatrix::silent_generate(OT_ROLE role, size_t n)
+{
+    int depth = SilentOT::get_depth(n);
+    int n_trees = SilentOT::NOISE_WEIGHT;
+    int tree_size = 1 << depth;
+    int n_base = DIV_CEIL(n_trees * depth, 128) * 128;
+
+    if (OnlineOptions::singleton.has_option("verbose_ot"))
+        fprintf(stderr, "%zu silent OTs from %d trees of depth %d\n", n,
+                n_trees, depth);
+
+    // random OTs for choosing the siblings off the punctured paths
+    vector<int> alphas;
+    BitVector off_path(n_base);
+    off_path.randomize(G);
+    if (role & RECEIVER)
+        for (int j = 0; j < n_trees; j++)
+        {
+            alphas.push_back(G.get_uint(tree_size));
+            for (int l = 0; l < depth; l++)
+                off_path.set_bit(j * depth + l,
+                        not ((alphas[j] >> (depth - l - 1)) & 1));
+        }
+
+    auto orig_role = ot_role;
+    ot_role = role;
+    extend_correlated(n_base, off_path, true);
+
+    vector<octetStream> os(2);
+    vector<int128> sender_leaves, receiver_leaves;
+    vector<int> noise_positions;
+
+    if (role & SENDER)
+    {
+        __m128i delta = baseReceiverInput.get_int128(0).a;
+        sender_leaves.resize(n_trees * tree_size);
+        vector<array<int128, 2>> sums(depth);
+        for (int j = 0; j < n_trees; j++)
+        {
+            auto leaves = &sender_leaves[j * tree_size];
+            silent.expand(leaves, G.get_doubleword(), depth, sums.data());
+            for (int l = 0; l < depth; l++)
+                for (int b = 0; b < 2; b++)
+                    os[0].serialize(
+                            sums[l][b] ^ senderOutputMatrices[b][j * depth + l]);
+            int128 sum = delta;
+            for (int i = 0; i < tree_size; i++)
+                sum ^= leaves[i];
+            os[0].serialize(sum);
+        }
+    }
+
+    send_if_ot_sender(player, os, role);
+
+    if (role & RECEIVER)
+    {
+        receiver_leaves.resize(n_trees * tree_size);
+        vector<int128> sums(depth);
+        for (int j = 0; j < n_trees; j++)
+        {
+            for (int l = 0; l < depth; l++)
+            {
+                int128 masked[2];
+                os[1].unserialize(masked);
+                sums[l] = masked[off_path.get_bit(j * depth + l)]
+                        ^ receiverOutputMatrix[j * depth + l];
+            }
+            int128 sum;
+            os[1].unserialize(sum);
+
+            auto leaves = &receiver_leaves[j * tree_size];
+            int alpha = alphas[j];
+            silent.puncture(leaves, alpha, depth, sums.data());
+            for (int i = 0; i < tree_size; i++)
+                if (i != alpha)
+                    sum ^= leaves[i];
+            leaves[alpha] = sum;
+            noise_positions.push_back(j * tree_size + alpha);
+        }
+    }
+
+    ot_role = orig_role;
+    silent.compress(n, sender_leaves, receiver_leaves, noise_positions);
+}
+
+void OTExtensionWithMatrix::silent_extend(int nOTs,
+        const BitVector& newReceiverInput)
+{
+    CODE_LOCATION
+    assert(nOTs >= 0);
+    size_t n = nOTs;
+
+    if ((ot_role & RECEIVER) and newReceiverInput.size() != n)
+        throw runtime_error("wrong number of choice bits");
+
+    // the other party needs the same
+    int role = 0;
+    if ((ot_role & SENDER) and silent.sender_left() < n)
+        role |= SENDER;
+    if ((ot_role & RECEIVER) and silent.receiver_left() < n)
+        role |= RECEIVER;
+    if (role)
+        silent_generate(OT_ROLE(role), max(n, size_t(SilentOT::MIN_BATCH)));
+
+    resize(DIV_CEIL(nOTs, 128) * 128);
+
+    // derandomize the choice bits
+    vector<octetStream> os(2);
+    if (ot_role & RECEIVER)
+    {
+        BitVector diff(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t j = silent.receiver_pos + i;
+            diff.set_bit(i, newReceiverInput.get_bit(i) ^ silent.choices.get_bit(j));
+            receiverOutputMatrix[i] = silent.receiver_outputs[j].a;
+        }
+        silent.receiver_pos += n;
+        diff.pack(os[0]);
+    }
+
+    send_if_ot_receiver(player, os, ot_role);
+
+    if (ot_role & SENDER)
+    {
+        BitVector diff;
+        diff.unpack(os[1]);
+        if (diff.size() != n)
+            throw runtime_error("wrong number of choice bits");
+        __m128i delta = baseReceiverInput.get_int128(0).a;
+        for (size_t i = 0; i < n; i++)
+            senderOutputMatrices[0][i] =
+                    silent.sender_outputs[silent.sender_pos + i].a
+                            ^ (diff.get_bit(i) ? delta : _mm_setzero_si128());
+        silent.sender_pos += n;
+    }
+}
+
 void OTExtensionWithMatrix::extend_correlated(const BitVector& newReceiverInput)
 {
     extend_correlated(newReceiverInput.size(), newReceiverInput);
 }
 
-void OTExtensionWithMatrix::extend_correlated(int nOTs_requested, const BitVector& newReceiverBits)
+void OTExtensionWithMatrix::extend_correlated(int nOTs_requested,
+        const BitVector& newReceiverBits, bool hash)
 {
     CODE_LOCATION
 //    if (nOTs % nbaseOTs != 0)
@@ -278,7 +437,8 @@ void OTExtensionWithMatrix::extend_correlated(int nOTs_requested, const BitVecto
     {
         expand(start, slice);
         this->correlate(start, slice, newReceiverInput, true);
-        transpose(start, slice);
+        // the correlation check needs the unhashed outputs
+        transpose(start, slice, hash and passive_only);
     }
 
 #ifdef OTEXT_TIMER
@@ -304,6 +464,9 @@ void OTExtensionWithMatrix::extend_correlated(int nOTs_requested, const BitVecto
     senderOutputMatrices[0].resize(nOTs_requested_rounded);
     senderOutputMatrices[1].resize(nOTs_requested_rounded);
     newReceiverInput.resize(nOTs_requested);
+
+    if (hash and not passive_only)
+        hash_outputs(nOTs_requested);
 }
 
 void OTExtensionWithMatrix::expand_transposed()
@@ -322,7 +485,7 @@ void OTExtensionWithMatrix::expand_transposed()
     }
 }
 
-void OTExtensionWithMatrix::transpose(int start, int slice)
+void OTExtensionWithMatrix::transpose(int start, int slice, bool hash)
 {
     if (slice < 0)
         slice = receiverOutputMatrix.squares.size();
@@ -341,10 +504,28 @@ void OTExtensionWithMatrix::transpose(int start, int slice)
     gettimeofday(&transt1, NULL);
 #endif
     // transpose in 128-bit chunks
-    if (ot_role & RECEIVER)
-        receiverOutputSlice.transpose();
-    if (ot_role & SENDER)
-        senderOutputSlices[0].transpose();
+    if (hash)
+    {
+        // hash a few squares at a time while they are in cache
+        MMO mmo;
+        const int block = 8;
+        for (int i = start; i < start + slice; i += block)
+        {
+            int n = min(block, start + slice - i);
+            if (ot_role & RECEIVER)
+                square128::transpose(&receiverOutputMatrix.squares[i], n);
+            if (ot_role & SENDER)
+                square128::transpose(&senderOutputMatrices[0].squares[i], n);
+            hash_rows(mmo, 128 * i, 128 * (i + n));
+        }
+    }
+    else
+    {
+        if (ot_role & RECEIVER)
+            receiverOutputSlice.transpose();
+        if (ot_role & SENDER)
+            senderOutputSlices[0].transpose();
+    }
 
 #ifdef OTEXT_TIMER
     gettimeofday(&transt2, NULL);
@@ -362,6 +543,29 @@ void OTExtensionWithMatrix::hash_outputs(int nOTs)
     hash_outputs(nOTs, senderOutputMatrices, receiverOutputMatrix);
 }
 
+// in place, same result as hash_outputs()
+void OTExtensionWithMatrix::hash_rows(MMO& mmo, int start, int end)
+{
+    __m128i delta = baseReceiverInput.get_int128(0).a;
+    for (int i = start; i < end; i += 8)
+    {
+        if (ot_role & SENDER)
+        {
+            auto q = &senderOutputMatrices[0][i];
+            __m128i tmp[8];
+            for (int j = 0; j < 8; j++)
+                tmp[j] = q[j] ^ delta;
+            mmo.hashEightBlocks(&senderOutputMatrices[1][i], tmp);
+            mmo.hashEightBlocks(q, q);
+        }
+        if (ot_role & RECEIVER)
+        {
+            auto t = &receiverOutputMatrix[i];
+            mmo.hashEightBlocks(t, t);
+        }
+    }
+}
+
 octet* OTExtensionWithMatrix::get_receiver_output(int i)
 {
     return (octet*)&receiverOutputMatrix.squares[i/128].rows[i%128];
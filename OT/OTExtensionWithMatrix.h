@@ -8,6 +8,7 @@
 
 #include "OTExtension.h"
 #include "BitMatrix.h"
+#include "SilentOT.h"
 #include "Math/gf2n.h"
 
 #ifndef USE_KOS
@@ -16,6 +17,8 @@ class Channel;
 }
 #endif
 
+class MMO;
+
 template <class U>
 class OTCorrelator : public OTExtension
 {
@@ -65,8 +68,14 @@ class OTExtensionWithMatrix : public OTCorrelator<BitMatrix>
 
     int softspoken_k;
 
+    SilentOT silent;
+
     void init_me();
 
+    void silent_generate(OT_ROLE role, size_t n);
+
+    void hash_rows(MMO& mmo, int start, int end);
+
 public:
     PRNG G;
 
@@ -88,13 +97,15 @@ public:
     ~OTExtensionWithMatrix();
 
     bool use_kos();
+    bool use_silent();
     void protocol_agreement();
 
     void transfer(int nOTs, const BitVector& receiverInput, int nloops);
     void extend(int nOTs, const BitVector& newReceiverInput, bool hash = true);
     void extend_correlated(const BitVector& newReceiverInput);
-    void extend_correlated(int nOTs, const BitVector& newReceiverInput);
-    void transpose(int start = 0, int slice = -1);
+    void extend_correlated(int nOTs, const BitVector& newReceiverInput,
+            bool hash = false);
+    void transpose(int start = 0, int slice = -1, bool hash = false);
     void expand_transposed();
     template <class V>
     void hash_outputs(int nOTs, vector<V>& senderOutput, V& receiverOutput,
@@ -104,6 +115,9 @@ public:
     void soft_sender(size_t nOTs);
     void soft_receiver(size_t nOTs, const BitVector& newReceiverInput);
 
+    // silent OT (correlated outputs like KOS)
+    void silent_extend(int nOTs, const BitVector& newReceiverInput);
+
     void print(BitVector& newReceiverInput, int i = 0);
     template <class T>
     void print_receiver(BitVector& newReceiverInput, BitMatrix& matrix, int i = 0, int offset = 0);
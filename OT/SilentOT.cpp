@@ -0,0 +1,154 @@
+/*
+ * SilentOT.cpp
+ *
+ */
+
+#include "SilentOT.h"
+#include "Tools/aes.h"
+#include "Tools/int.h"
+
+int SilentOT::get_depth(size_t n_outputs)
+{
+    size_t leaves = DIV_CEIL(SCALER * n_outputs, NOISE_WEIGHT);
+    int depth = 1;
+    while ((1ul << depth) < leaves)
+        depth++;
+    return depth;
+}
+
+SilentOT::SilentOT() :
+        sender_pos(0), receiver_pos(0)
+{
+    // fixed keys for the tree expansion
+    for (int i = 0; i < 2; i++)
+    {
+        octet key[AES_BLK_SIZE] = {};
+        key[0] = i;
+        aes_128_schedule(keys[i], key);
+    }
+}
+
+void SilentOT::expand_level(int128* nodes, int n_parents) const
+{
+    // from the back so that parents are read before being overwritten
+    int i = n_parents;
+    while (i > 0)
+    {
+        int n = min(i, 8);
+        i -= n;
+        __m128i parents[8], children[2][8];
+        for (int j = 0; j < n; j++)
+            parents[j] = nodes[i + j].a;
+        for (int b = 0; b < 2; b++)
+            if (n == 8)
+                ecb_aes_128_encrypt<8>(children[b], parents, keys[b]);
+            else
+                for (int j = 0; j < n; j++)
+                    children[b][j] = aes_128_encrypt(parents[j], keys[b]);
+        for (int j = 0; j < n; j++)
+            for (int b = 0; b < 2; b++)
+                nodes[2 * (i + j) + b] = children[b][j] ^ parents[j];
+    }
+}
+
+void SilentOT::expand(int128* leaves, int128 seed, int depth,
+        array<int128, 2>* sums) const
+{
+    leaves[0] = seed;
+    for (int l = 0; l < depth; l++)
+    {
+        expand_level(leaves, 1 << l);
+        sums[l] = {};
+        for (int i = 0; i < 2 << l; i++)
+            sums[l][i % 2] ^= leaves[i];
+    }
+}
+
+void SilentOT::puncture(int128* leaves, int alpha, int depth,
+        const int128* sums) const
+{
+    leaves[0] = {};
+    int path = 0;
+    for (int l = 0; l < depth; l++)
+    {
+        expand_level(leaves, 1 << l);
+        int bit = (alpha >> (depth - l - 1)) & 1;
+        int sibling = 2 * path + 1 - bit;
+        int128 sum = sums[l];
+        for (int i = 1 - bit; i < 2 << l; i += 2)
+            if (i != sibling)
+                sum ^= leaves[i];
+        leaves[sibling] = sum;
+        path = 2 * path + bit;
+        leaves[path] = {};
+    }
+}
+
+void SilentOT::compress(size_t n_outputs, vector<int128>& sender_leaves,
+        vector<int128>& receiver_leaves, const vector<int>& noise_positions)
+{
+    bool sender = not sender_leaves.empty();
+    bool receiver = not receiver_leaves.empty();
+    size_t n = max(sender_leaves.size(), receiver_leaves.size());
+
+    // accumulate
+    vector<char> noise;
+    if (receiver)
+    {
+        noise.resize(n);
+        for (int x : noise_positions)
+            noise.at(x) ^= 1;
+    }
+    for (size_t i = 1; i < n; i++)
+    {
+        if (sender)
+            sender_leaves[i] ^= sender_leaves[i - 1];
+        if (receiver)
+        {
+            receiver_leaves[i] ^= receiver_leaves[i - 1];
+            noise[i] ^= noise[i - 1];
+        }
+    }
+
+    // keep what hasn't been used
+    sender_outputs.erase(sender_outputs.begin(),
+            sender_outputs.begin() + sender_pos);
+    receiver_outputs.erase(receiver_outputs.begin(),
+            receiver_outputs.begin() + receiver_pos);
+    BitVector old_choices = choices;
+    size_t n_old = receiver_outputs.size();
+    choices.resize(n_old + (receiver ? n_outputs : 0));
+    for (size_t i = 0; i < n_old; i++)
+        choices.set_bit(i, old_choices.get_bit(receiver_pos + i));
+    sender_pos = receiver_pos = 0;
+
+    // expand with a regular code from a public seed
+    PRNG G;
+    octet seed[SEED_SIZE] = {};
+    G.SetSeed(seed);
+    size_t segment = n / EXPANDER_WEIGHT;
+    assert(segment > 0);
+    for (size_t j = 0; j < n_outputs; j++)
+    {
+        int128 v, w;
+        char b = 0;
+        for (int k = 0; k < EXPANDER_WEIGHT; k++)
+        {
+            size_t index = k * segment + ((uint64_t(G.get_uint()) * segment) >> 32);
+            if (sender)
+                v ^= sender_leaves[index];
+            if (receiver)
+            {
+                w ^= receiver_leaves[index];
+                b ^= noise[index];
+            }
+        }
+        if (sender)
+            sender_outputs.push_back(v);
+        if (receiver)
+        {
+            choices.set_bit(receiver_outputs.size(), b);
+            receiver_outputs.push_back(w);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * SilentOT.h
+ *
+ */
+
+#ifndef OT_SILENTOT_H_
+#define OT_SILENTOT_H_
+
+#include "Tools/BitVector.h"
+#include "Tools/random.h"
+#include "Math/gf2nlong.h"
+
+#include <vector>
+#include <array>
+using namespace std;
+
+/*
+ * Local part of correlated OT with communication sublinear in the
+ * number of OTs from a pseudorandom correlation generator
+ * (Boyle et al., CCS 2019). GGM trees yield single-point correlated OTs
+ * for a regular noise vector, which is compressed into the outputs with
+ * the dual of an expand-accumulate code (Boyle et al., Crypto 2022).
+ * The protocol is in OTExtensionWithMatrix::silent_extend().
+ */
+class SilentOT
+{
+    octet keys[2][176] __attribute__((aligned (16)));
+
+    void expand_level(int128* nodes, int n_parents) const;
+
+public:
+    // noise weight for a minimum distance ratio of 0.1,
+    // expander weight and expansion as for the code in libOTe
+    static const int NOISE_WEIGHT = 400;
+    static const int EXPANDER_WEIGHT = 21;
+    static const int SCALER = 2;
+
+    // amortize the trees over enough OTs
+    static const int MIN_BATCH = 1 << 18;
+
+    // random correlated OTs with sender ^ receiver = choices * delta
+    vector<int128> sender_outputs, receiver_outputs;
+    BitVector choices;
+    size_t sender_pos, receiver_pos;
+
+    static int get_depth(size_t n_outputs);
+
+    SilentOT();
+
+    size_t sender_left() const { return sender_outputs.size() - sender_pos; }
+    size_t receiver_left() const { return receiver_outputs.size() - receiver_pos; }
+
+    // all 2^depth leaves and the sums of left and right nodes per level
+    void expand(int128* leaves, int128 seed, int depth,
+            array<int128, 2>* sums) const;
+    // all leaves but the one at alpha from the sums of the nodes
+    // off the path to alpha
+    void puncture(int128* leaves, int alpha, int depth,
+            const int128* sums) const;
+
+    // compress the tree outputs into n_outputs further correlated OTs,
+    // leaves are overwritten
+    void compress(size_t n_outputs, vector<int128>& sender_leaves,
+            vector<int128>& receiver_leaves,
+            const vector<int>& noise_positions);
+};
+
+#endif /* OT_SILENTOT_H_ */
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
+#include <sys/types.h>
 
 using namespace std;
 
@@ -14,16 +15,50 @@ using namespace std;
  * Provides generalised file read and write methods for arrays of numeric data types.
  * Stateless and not optimised for multiple reads from file.
  * Intended for MPC application specific file IO.
+ *
+ * Ranges are transferred with positioned bulk I/O, so threads can
+ * access disjoint ranges of the same file concurrently.
  */
 
 template<class T>
 class Binary_File_IO
 {
+  static const size_t BLOCK_SIZE = 1 << 16;
+
+  /*
+   * Whether the binary representation of a range equals its memory,
+   * which allows transferring it without conversion.
+   */
+  static bool has_raw_layout() { return sizeof(T) == size_t(T::size()); }
+
+  // position of the first element after checking the signature
+  static long data_start(const string& filename);
+
+  static void write_all(int fd, const char* data, size_t length, off_t pos,
+      const string& filename);
+  static void read_all(int fd, char* data, size_t length, off_t pos);
+
   public:
 
   static string filename(int my_number);
   static void reset(int my_number);
 
+  /*
+   * Write n elements at position start_pos (-1 for the end of the file).
+   * The file is extended sparsely if start_pos is beyond the end.
+   * Throws file_error.
+   */
+  void write_range(const string& filename, const T* buffer, size_t n,
+      long start_pos);
+
+  /*
+   * Read n elements from position start_pos.
+   * Returns the position after the range or -1 if at eof.
+   * Throws file_missing, file_error, or persistence_error.
+   */
+  long read_range(const string& filename, T* buffer, size_t n,
+      long start_pos);
+
   /*
    * Append the buffer values as binary to the filename.
    * Throws file_error.   
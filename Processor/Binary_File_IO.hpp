@@ -1,5 +1,9 @@
 #include "Processor/Binary_File_IO.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
 /* 
  * Provides generalised file read and write methods for arrays of shares.
  * Stateless and not optimised for multiple reads from file.
@@ -34,107 +38,187 @@ void Binary_File_IO<T>::reset(int my_number)
 }
 
 template<class T>
-void Binary_File_IO<T>::write_to_file(const string filename,
-    const vector<T>& buffer, long start_pos)
+long Binary_File_IO<T>::data_start(const string& filename)
 {
-  ofstream outf;
+  ifstream file(filename, ios::in | ios::binary);
+  if (file.fail())
+    throw file_missing(filename, "Binary_File_IO expects this file to exist.");
 
-  outf.open(filename, ios::out | ios::binary | ios::ate | ios::in);
-  if (outf.fail()) {
+  try
+  {
+    check_file_signature<T>(file, filename);
+  }
+  catch (exception& e)
+  {
+    throw persistence_error(e.what());
+  }
+
+  return file.tellg();
+}
+
+template<class T>
+void Binary_File_IO<T>::write_range(const string& filename, const T* buffer,
+    size_t n, long start_pos)
+{
+  long start;
+  try
+  {
+    start = data_start(filename);
+  }
+  catch (file_missing&)
+  {
+    throw file_error(filename);
+  }
+
+  int fd = open(filename.c_str(), O_WRONLY);
+  if (fd < 0)
+  {
     cerr << "open failure as expected: " << strerror(errno) << '\n';
     throw file_error(filename);
   }
 
-  if (start_pos != -1)
+  off_t pos;
+  if (start_pos == -1)
+    pos = lseek(fd, 0, SEEK_END);
+  else
+    pos = start + start_pos * T::size();
+  if (pos < 0)
     {
-      long write_pos = ((long)file_signature<T>().get_total_length()) + start_pos * (long)T::size();
-      // fill with zeros if needed
-      for (long i = outf.tellp(); i < write_pos; i++) {
-        outf.put(0);
-        std::cout << "0" << std::endl;
-      }
-      outf.seekp(write_pos);
+      close(fd);
+      throw file_error(filename);
     }
 
-  for (unsigned long i = 0; i < buffer.size(); i++)
+  // a gap before pos is left as a hole by the file system
+  try
+  {
+    if (has_raw_layout())
+      write_all(fd, (const char*) buffer, n * T::size(), pos, filename);
+    else
+    {
+      stringstream ss;
+      for (size_t i = 0; i < n; i += BLOCK_SIZE)
+        {
+          ss.str("");
+          for (size_t j = i; j < min(n, i + BLOCK_SIZE); j++)
+            buffer[j].output(ss, false);
+          string block = ss.str();
+          write_all(fd, block.data(), block.size(), pos, filename);
+          pos += block.size();
+        }
+    }
+  }
+  catch (...)
   {
-    buffer[i].output(outf, false);
+    close(fd);
+    throw;
   }
 
-  if (outf.fail())
-    throw runtime_error("failed writing to " + filename);
+  close(fd);
+}
 
-  outf.close();
+template<class T>
+void Binary_File_IO<T>::write_all(int fd, const char* data, size_t length,
+    off_t pos, const string& filename)
+{
+  while (length > 0)
+    {
+      ssize_t res = pwrite(fd, data, length, pos);
+      if (res < 0 and errno == EINTR)
+        continue;
+      if (res <= 0)
+        throw runtime_error("failed writing to " + filename + ": " + strerror(errno));
+      data += res;
+      length -= res;
+      pos += res;
+    }
 }
 
 template<class T>
-void Binary_File_IO<T>::read_from_file(const string filename, vector<T>& buffer,
-    const long start_posn, long& end_posn)
+void Binary_File_IO<T>::write_to_file(const string filename,
+    const vector<T>& buffer, long start_pos)
+{
+  write_range(filename, buffer.data(), buffer.size(), start_pos);
+}
+
+template<class T>
+long Binary_File_IO<T>::read_range(const string& filename, T* buffer,
+    size_t n, long start_posn)
 {
-  ifstream inf;
-  inf.open(filename, ios::in | ios::binary);
-  if (inf.fail()) { throw file_missing(filename, "Binary_File_IO.read_from_file expects this file to exist."); }
+  long start = data_start(filename);
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw file_missing(filename, "Binary_File_IO.read_from_file expects this file to exist.");
+
+  struct stat st;
+  if (fstat(fd, &st) < 0)
+    {
+      close(fd);
+      throw file_error(filename);
+    }
+  off_t pos = start + start_posn * T::size();
+  size_t size_in_bytes = n * T::size();
+
+  if (pos + off_t(size_in_bytes) > st.st_size)
+    {
+      close(fd);
+      stringstream ss;
+      ss << "Got to EOF when reading from disk (expecting " << size_in_bytes
+          << " bytes from " << pos << ").";
+      throw persistence_error(ss.str());
+    }
 
   try
   {
-    check_file_signature<T>(inf, filename).get_length();
+    if (has_raw_layout())
+      read_all(fd, (char*) buffer, size_in_bytes, pos);
+    else
+    {
+      vector<char> block;
+      for (size_t i = 0; i < n; i += BLOCK_SIZE)
+        {
+          size_t n_block = min(n, i + BLOCK_SIZE) - i;
+          block.resize(n_block * T::size());
+          read_all(fd, block.data(), block.size(), pos);
+          pos += block.size();
+          for (size_t j = 0; j < n_block; j++)
+            buffer[i + j].assign(&block[j * T::size()]);
+        }
+    }
   }
-  catch (exception& e)
+  catch (...)
   {
-    throw persistence_error(e.what());
+    close(fd);
+    throw;
   }
 
-  auto data_start = inf.tellg();
+  close(fd);
 
-  unsigned long size_in_bytes = ((unsigned long)T::size()) * buffer.size();
-  unsigned long n_read = 0;
+  if (start + off_t((start_posn + n) * T::size()) >= st.st_size)
+    return -1;
+  else
+    return start_posn + n;
+}
 
-  // this char array is causing issues
-  char *read_buffer = new char[size_in_bytes];
-  inf.seekg(((unsigned long)start_posn) * ((unsigned long)T::size()), iostream::cur);
-  do
-  {
-      inf.read(read_buffer + n_read, size_in_bytes - n_read);
-      n_read += inf.gcount();
-
-      if (inf.eof())
-      {
-        stringstream ss;
-        ss << "Got to EOF when reading from disk (expecting " << size_in_bytes
-            << " bytes from " << (long(data_start) + start_posn * T::size())
-            << ").";
-        throw persistence_error(ss.str());
-      }
-      if (inf.fail())
-      {
-        stringstream ss;
-        ss << "IO problem when reading from disk";
-        throw persistence_error(ss.str());
-      }
-  }
-  while (n_read < size_in_bytes);
-
-//  std::cout << "Read buffer " << std::endl;
-//    for (int i=0; i < size_in_bytes; ++i) {
-//        if (! (i % 16) && i)
-//            printf("\n");
-//
-//        printf("0x%02x ", read[i]);
-//    }
-//    printf("\n\n");
-//  print_hex(read_buffer, size_in_bytes);
-
-  end_posn = (inf.tellg() - data_start) / T::size();
-  assert (end_posn == start_posn + int(buffer.size()));
-
-  //Check if at end of file by getting 1 more char.
-  inf.get();
-  if (inf.eof())
-    end_posn = -1;
-  inf.close();
-
-  for (unsigned int i = 0; i < buffer.size(); i++)
-    buffer[i].assign(&read_buffer[((unsigned long)i)*((unsigned long)T::size())]);
-
-  delete[] read_buffer;
+template<class T>
+void Binary_File_IO<T>::read_all(int fd, char* data, size_t length, off_t pos)
+{
+  while (length > 0)
+    {
+      ssize_t res = pread(fd, data, length, pos);
+      if (res < 0 and errno == EINTR)
+        continue;
+      if (res <= 0)
+        throw persistence_error("IO problem when reading from disk");
+      data += res;
+      length -= res;
+      pos += res;
+    }
+}
+
+template<class T>
+void Binary_File_IO<T>::read_from_file(const string filename, vector<T>& buffer,
+    const long start_posn, long& end_posn)
+{
+  end_posn = read_range(filename, buffer.data(), buffer.size(), start_posn);
 }
@@ -23,7 +23,6 @@ public:
     size_t r0;
     size_t r1;
     int r2;
-    vector<vector<vector<int>>> lengths;
     int filter_stride_h = 1;
     int filter_stride_w = 1;
 
@@ -31,6 +30,11 @@ public:
 
     array<int, 3> matrix_dimensions();
 
+    int get_length(int out_y, int out_x);
+
+    template<class T>
+    void pre_matmul(SubProcessor<T>& processor);
+
     template<class T>
     void pre(StackedVector<T>& S, typename T::Protocol& protocol);
     template<class T>
@@ -8,12 +8,15 @@
 #include "Math/Setup.h"
 #include "GC/BitPrepFiles.h"
 #include "Tools/benchmarking.h"
+#include "Protocols/PrepProducer.hpp"
 
 template<class T>
 Preprocessing<T>* Preprocessing<T>::get_live_prep(SubProcessor<T>* proc,
     DataPositions& usage)
 {
-  return new typename T::LivePrep(proc, usage);
+  auto res = new typename T::LivePrep(proc, usage);
+  LivePrepProducer<T>::install(*res);
+  return res;
 }
 
 template<class T>
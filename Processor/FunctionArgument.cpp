@@ -7,13 +7,19 @@
 
 #include <fstream>
 
-void FunctionArgument::open(ifstream& file, const string& name,
+string FunctionArgument::get_filename(const string& name,
         vector<FunctionArgument>& arguments)
 {
     string signature;
     for (auto& arg : arguments)
         signature += "-" + arg.get_type_string();
-    string filename = "Programs/Functions/" + name + signature;
+    return "Programs/Functions/" + name + signature;
+}
+
+void FunctionArgument::open(ifstream& file, const string& name,
+        vector<FunctionArgument>& arguments)
+{
+    string filename = get_filename(name, arguments);
 
     file.open(filename);
     if (not file.good())
@@ -34,6 +40,26 @@ void FunctionArgument::open(ifstream& file, const string& name,
     }
 }
 
+FunctionDescriptor::FunctionDescriptor(const string& name,
+        vector<FunctionArgument>& arguments) :
+        arg_regs(arguments.size()), address_regs(arguments.size())
+{
+    ifstream file;
+    FunctionArgument::open(file, name, arguments);
+
+    file >> progname >> tape_number >> return_type >> return_reg;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        file >> arg_regs.at(i);
+        if (arguments[i].get_memory())
+            file >> address_regs.at(i);
+    }
+
+    if (not file.good())
+        throw runtime_error("error reading file for function " + name);
+}
+
 void FunctionArgument::check_type(const string& type_string)
 {
     if (type_string != get_type_string()
@@ -21,6 +21,8 @@ class FunctionArgument
     bool memory;
 
 public:
+    static string get_filename(const string& name,
+            vector<FunctionArgument>& arguments);
     static void open(ifstream& file, const string& name,
             vector<FunctionArgument>& arguments);
 
@@ -138,4 +140,19 @@ public:
     void check_type(const string& type_string);
 };
 
+/**
+ * Compiler output for an exported function with a particular signature,
+ * read once and then reused for every call.
+ */
+class FunctionDescriptor
+{
+public:
+    string progname, return_type;
+    int tape_number, return_reg;
+    vector<int> arg_regs, address_regs;
+
+    FunctionDescriptor(const string& name,
+            vector<FunctionArgument>& arguments);
+};
+
 #endif /* PROCESSOR_FUNCTIONARGUMENT_H_ */
@@ -0,0 +1,107 @@
+/*
+ * FunctionSession.h
+ *
+ */
+
+#ifndef PROCESSOR_FUNCTIONSESSION_H_
+#define PROCESSOR_FUNCTIONSESSION_H_
+
+#include "Processor/Machine.h"
+#include "Processor/FunctionArgument.h"
+#include "Tools/octetStream.h"
+
+#include <deque>
+
+/**
+ * Packing of function arguments for transfer between a controller
+ * and a resident virtual machine.
+ */
+template<class sint>
+class FunctionArguments
+{
+    typedef typename sint::bit_type bit_type;
+
+    // deques to keep references stable
+    deque<vector<sint>> shares;
+    deque<vector<vector<bit_type>>> bits;
+    deque<vector<long>> integers;
+
+    FunctionArgument unpack_one(octetStream& os);
+
+public:
+    FunctionArgument result;
+    vector<FunctionArgument> arguments;
+
+    static void pack(octetStream& os, FunctionArgument& argument);
+    static void pack_values(octetStream& os, FunctionArgument& argument);
+    static void unpack_values(octetStream& os, FunctionArgument& argument);
+
+    void unpack(octetStream& os);
+};
+
+/**
+ * Resident virtual machine serving function calls from a controller
+ * process on a Unix domain socket. Tapes, connections, and
+ * preprocessing are kept between calls.
+ */
+template<class sint, class sgf2n = NoShare<gf2n>>
+class FunctionSession
+{
+    Machine<sint, sgf2n>& machine;
+    string socket_path;
+    int listen_socket;
+
+public:
+    enum Command
+    {
+        CALL,
+        STOP,
+    };
+
+    /**
+     * Listen on ``socket_path``.
+     *
+     * @param machine virtual machine to run functions on
+     * @param socket_path Unix domain socket path
+     */
+    FunctionSession(Machine<sint, sgf2n>& machine, const string& socket_path);
+    ~FunctionSession();
+
+    /**
+     * Accept one controller and serve its calls until it stops.
+     * All parties have to receive the same sequence of calls.
+     * Errors before the computation starts are reported to the
+     * controller, later errors end the session.
+     */
+    void run();
+};
+
+/**
+ * Controller of a resident virtual machine (one per party).
+ */
+template<class sint>
+class FunctionClient
+{
+    int socket;
+
+public:
+    /**
+     * Connect to ``socket_path``.
+     */
+    FunctionClient(const string& socket_path);
+    ~FunctionClient();
+
+    /**
+     * Call function with the same semantics as ``Machine::run_function()``.
+     * Array arguments are updated with the output of the function.
+     */
+    void call(const string& name, FunctionArgument& result,
+            vector<FunctionArgument>& arguments);
+
+    /**
+     * Let the virtual machine finish.
+     */
+    void stop();
+};
+
+#endif /* PROCESSOR_FUNCTIONSESSION_H_ */
@@ -0,0 +1,284 @@
+/*
+ * FunctionSession.hpp
+ *
+ */
+
+#ifndef PROCESSOR_FUNCTIONSESSION_HPP_
+#define PROCESSOR_FUNCTIONSESSION_HPP_
+
+#include "FunctionSession.h"
+#include "Networking/sockets.h"
+
+#include <sys/un.h>
+
+template<class sint>
+void FunctionArguments<sint>::pack(octetStream& os,
+        FunctionArgument& argument)
+{
+    if (argument.has_reg_type("sbv"))
+        os.store(string("sbv"));
+    else if (argument.has_reg_type("ci"))
+        os.store(string("ci"));
+    else
+        os.store(string("s"));
+    os.store(argument.get_size());
+    os.store(argument.get_n_bits());
+    os.store_int(argument.get_memory(), 1);
+    pack_values(os, argument);
+}
+
+template<class sint>
+void FunctionArguments<sint>::pack_values(octetStream& os,
+        FunctionArgument& argument)
+{
+    size_t size = argument.get_size();
+    if (argument.get_n_bits())
+    {
+        for (size_t j = 0; j < size; j++)
+            for (auto& x : argument.get_value<vector<bit_type>>(j))
+                x.pack(os);
+    }
+    else if (argument.has_reg_type("ci"))
+    {
+        for (size_t j = 0; j < size; j++)
+            os.store_int(argument.get_value<long>(j), 8);
+    }
+    else
+    {
+        for (size_t j = 0; j < size; j++)
+            argument.get_value<sint>(j).pack(os);
+    }
+}
+
+template<class sint>
+void FunctionArguments<sint>::unpack_values(octetStream& os,
+        FunctionArgument& argument)
+{
+    size_t size = argument.get_size();
+    if (argument.get_n_bits())
+    {
+        for (size_t j = 0; j < size; j++)
+            for (auto& x : argument.get_value<vector<bit_type>>(j))
+                x.unpack(os);
+    }
+    else if (argument.has_reg_type("ci"))
+    {
+        for (size_t j = 0; j < size; j++)
+            argument.get_value<long>(j) = os.get_int(8);
+    }
+    else
+    {
+        for (size_t j = 0; j < size; j++)
+            argument.get_value<sint>(j).unpack(os);
+    }
+}
+
+template<class sint>
+FunctionArgument FunctionArguments<sint>::unpack_one(octetStream& os)
+{
+    string reg_type;
+    size_t size, n_bits;
+    os.get(reg_type);
+    os.get(size);
+    os.get(n_bits);
+    bool memory = os.get_int(1);
+
+    if (reg_type == "sbv")
+    {
+        size_t n_limbs = DIV_CEIL(n_bits, bit_type::default_length);
+        bits.push_back(
+                vector<vector<bit_type>>(size, vector<bit_type>(n_limbs)));
+        for (auto& x : bits.back())
+            for (auto& y : x)
+                y.unpack(os);
+        return {n_bits, bits.back()};
+    }
+    else if (reg_type == "ci")
+    {
+        integers.push_back(vector<long>(size));
+        for (auto& x : integers.back())
+            x = os.get_int(8);
+        return {integers.back()};
+    }
+    else if (reg_type == "s")
+    {
+        shares.push_back(vector<sint>(size));
+        for (auto& x : shares.back())
+            x.unpack(os);
+        return {shares.back(), memory};
+    }
+    else
+        throw runtime_error("unknown argument type: " + reg_type);
+}
+
+template<class sint>
+void FunctionArguments<sint>::unpack(octetStream& os)
+{
+    shares.clear();
+    bits.clear();
+    integers.clear();
+    arguments.clear();
+
+    size_t n_arguments;
+    os.get(n_arguments);
+    for (size_t i = 0; i < n_arguments; i++)
+        arguments.push_back(unpack_one(os));
+
+    size_t result_size;
+    os.get(result_size);
+    if (result_size)
+    {
+        shares.push_back(vector<sint>(result_size));
+        result = {shares.back()};
+    }
+    else
+        result = {};
+}
+
+template<class sint, class sgf2n>
+FunctionSession<sint, sgf2n>::FunctionSession(Machine<sint, sgf2n>& machine,
+        const string& socket_path) :
+        machine(machine), socket_path(socket_path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path))
+        throw runtime_error("socket path too long: " + socket_path);
+    strcpy(address.sun_path, socket_path.c_str());
+
+    listen_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_socket < 0)
+        error("FunctionSession: socket");
+
+    // remove leftover from previous session
+    unlink(socket_path.c_str());
+    if (bind(listen_socket, (sockaddr*) &address, sizeof(address)) < 0)
+        error("FunctionSession: bind");
+    if (listen(listen_socket, 1) < 0)
+        error("FunctionSession: listen");
+}
+
+template<class sint, class sgf2n>
+FunctionSession<sint, sgf2n>::~FunctionSession()
+{
+    close(listen_socket);
+    unlink(socket_path.c_str());
+}
+
+template<class sint, class sgf2n>
+void FunctionSession<sint, sgf2n>::run()
+{
+    int socket = accept(listen_socket, 0, 0);
+    if (socket < 0)
+        error("FunctionSession: accept");
+
+    octetStream os;
+    FunctionArguments<sint> call;
+
+    while (true)
+    {
+        os.Receive(socket);
+        if (os.get_int(1) == STOP)
+            break;
+
+        // only errors before the computation are reported to the
+        // controller, anything later ends the session
+        string name;
+        try
+        {
+            os.get(name);
+            call.unpack(os);
+            machine.prepare_function(name, call.result, call.arguments);
+        }
+        catch (exception& e)
+        {
+            os.reset_write_head();
+            os.store_int(false, 1);
+            os.store(string(e.what()));
+            os.Send(socket);
+            continue;
+        }
+
+        machine.run_function(name, call.result, call.arguments);
+
+        os.reset_write_head();
+        os.store_int(true, 1);
+        call.pack_values(os, call.result);
+        for (auto& arg : call.arguments)
+            if (arg.get_memory())
+                call.pack_values(os, arg);
+        os.Send(socket);
+    }
+
+    close(socket);
+}
+
+template<class sint>
+FunctionClient<sint>::FunctionClient(const string& socket_path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path))
+        throw runtime_error("socket path too long: " + socket_path);
+    strcpy(address.sun_path, socket_path.c_str());
+
+    socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket < 0)
+        error("FunctionClient: socket");
+
+    // the virtual machine might still be setting up
+    for (int i = 0; i < CONNECTION_TIMEOUT; i++)
+    {
+        if (connect(socket, (sockaddr*) &address, sizeof(address)) == 0)
+            return;
+        sleep(1);
+    }
+
+    error("FunctionClient: connect");
+}
+
+template<class sint>
+FunctionClient<sint>::~FunctionClient()
+{
+    close(socket);
+}
+
+template<class sint>
+void FunctionClient<sint>::call(const string& name, FunctionArgument& result,
+        vector<FunctionArgument>& arguments)
+{
+    octetStream os;
+    os.store_int(FunctionSession<sint>::CALL, 1);
+    os.store(name);
+    os.store(arguments.size());
+    for (auto& arg : arguments)
+        FunctionArguments<sint>::pack(os, arg);
+    assert(result.get_size() == 0 or result.has_reg_type("s"));
+    os.store(result.get_size());
+    os.Send(socket);
+
+    os.Receive(socket);
+    if (not os.get_int(1))
+    {
+        string message;
+        os.get(message);
+        throw runtime_error("function call failed: " + message);
+    }
+
+    FunctionArguments<sint>::unpack_values(os, result);
+    for (auto& arg : arguments)
+        if (arg.get_memory())
+            FunctionArguments<sint>::unpack_values(os, arg);
+}
+
+template<class sint>
+void FunctionClient<sint>::stop()
+{
+    octetStream os;
+    os.store_int(FunctionSession<sint>::STOP, 1);
+    os.Send(socket);
+}
+
+#endif /* PROCESSOR_FUNCTIONSESSION_HPP_ */
@@ -93,9 +93,9 @@ void Instruction::bitdecint(ArithmeticProcessor& Proc) const
     }
 }
 
-string BaseInstruction::get_name() const
+string BaseInstruction::get_name(int opcode)
 {
-    switch (get_opcode())
+    switch (opcode)
     {
 #define X(NAME, PRE, CODE) \
     case NAME: return #NAME;
@@ -106,7 +106,7 @@ string BaseInstruction::get_name() const
     COMBI_INSTRUCTIONS
     default:
         stringstream ss;
-        ss << showbase << hex << get_opcode();
+        ss << showbase << hex << opcode;
         return ss.str();
     }
 }
@@ -386,7 +386,8 @@ public:
   // Returns the maximal register used
   unsigned get_max_reg(int reg_type) const;
 
-  string get_name() const;
+  string get_name() const { return get_name(opcode); }
+  static string get_name(int opcode);
 };
 
 class DataPositions;
@@ -1493,6 +1493,10 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
   unsigned int size = p.size();
   Proc.PC=0;
 
+  ExecutionProfile::Tape* profile = 0;
+  if (ExecutionProfile::active())
+    profile = &Proc.profile.get_tape(name, size);
+
   auto& Procp = Proc.Procp;
   auto& Proc2 = Proc.Proc2;
 
@@ -1527,6 +1531,10 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
           cerr << instruction << endl;
 #endif
 
+      ExecutionProfile::Scope profile_scope(
+          profile ? &(*profile)[Proc.PC] : 0, instruction.get_opcode(),
+          Proc.P.get_comm_stats());
+
       Proc.PC++;
 
       switch(instruction.get_opcode())
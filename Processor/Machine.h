@@ -54,6 +54,9 @@ class Machine : public BaseMachine
 
   NamedCommStats max_comm;
 
+  // exported functions by descriptor filename
+  map<string, FunctionDescriptor> functions;
+
   size_t load_program(const string& threadname, const string& filename);
 
   void prepare(const string& progname_str);
@@ -94,6 +97,10 @@ class Machine : public BaseMachine
   void fill_buffers(int thread_number, int tape_number,
       Preprocessing<sint> *prep,
       Preprocessing<typename sint::bit_type> *bit_prep);
+  void fill_tuples(const vector<int>& args, Data_Files<sint, sgf2n>& DataF);
+  template<class T>
+  void fill_tuples(Preprocessing<T>& prep, const vector<BufferPrep<T>*>& dests,
+      const vector<DataPositions>& usages);
   template<int = 0>
   void fill_matmul(int thread_numbber, int tape_number,
       Preprocessing<sint> *prep, true_type);
@@ -108,6 +115,9 @@ class Machine : public BaseMachine
   void run_step(const string& progname);
   pair<DataPositions, NamedCommStats> stop_threads();
 
+  // load function and program without running
+  const FunctionDescriptor& prepare_function(const string& name,
+      FunctionArgument& result, vector<FunctionArgument>& arguments);
   void run_function(const string& name, FunctionArgument& result,
       vector<FunctionArgument>& arguments);
 
@@ -249,6 +249,7 @@ DataPositions Machine<sint, sgf2n>::run_tapes(const vector<int>& args,
   assert(args.size() % 3 == 0);
   for (unsigned i = 0; i < args.size(); i += 3)
     fill_buffers(args[i], args[i + 1], &DataF.DataFp, &DataF.DataFb);
+  fill_tuples(args, DataF);
   DataPositions res(N.num_players());
   for (unsigned i = 0; i < args.size(); i += 3)
     res.increase(
@@ -324,6 +325,47 @@ void Machine<sint, sgf2n>::fill_buffers(int thread_number, int tape_number,
     fill_matmul(thread_number, tape_number, prep, sint::triple_matmul);
 }
 
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::fill_tuples(const vector<int>& args,
+    Data_Files<sint, sgf2n>& DataF)
+{
+  // central preprocessing of all tuples for the threads,
+  // one batch per type to amortize the sacrifice
+  if (not live_prep or not opts.central_prep)
+    return;
+
+  vector<BufferPrep<sint>*> dests_p;
+  vector<BufferPrep<sgf2n>*> dests_2;
+  vector<DataPositions> usages;
+  for (unsigned i = 0; i < args.size(); i += 3)
+    {
+      auto& dest = tinfo[args[i]].processor->DataF;
+      dests_p.push_back(dynamic_cast<BufferPrep<sint>*>(&dest.DataFp));
+      dests_2.push_back(dynamic_cast<BufferPrep<sgf2n>*>(&dest.DataF2));
+      usages.push_back(progs[args[i + 1]].get_offline_data_used());
+    }
+
+  fill_tuples(DataF.DataFp, dests_p, usages);
+  fill_tuples(DataF.DataF2, dests_2, usages);
+}
+
+template<class sint, class sgf2n>
+template<class T>
+void Machine<sint, sgf2n>::fill_tuples(Preprocessing<T>& prep,
+    const vector<BufferPrep<T>*>& dests, const vector<DataPositions>& usages)
+{
+  auto source = dynamic_cast<BufferPrep<T>*>(&prep);
+  if (source == 0 or count(dests.begin(), dests.end(), nullptr))
+    {
+#ifdef VERBOSE_CENTRAL
+      cerr << "No central preprocessing for " << T::type_string() << endl;
+#endif
+      return;
+    }
+
+  source->buffer_central(dests, usages, &queues);
+}
+
 template<class sint, class sgf2n>
 template<int>
 void Machine<sint, sgf2n>::fill_matmul(int thread_number, int tape_number,
@@ -414,31 +456,36 @@ void Machine<sint, sgf2n>::run_step(const string& progname)
 }
 
 template<class sint, class sgf2n>
-void Machine<sint, sgf2n>::run_function(const string& name,
-        FunctionArgument& result, vector<FunctionArgument>& arguments)
+const FunctionDescriptor& Machine<sint, sgf2n>::prepare_function(
+    const string& name, FunctionArgument& result,
+    vector<FunctionArgument>& arguments)
 {
-  ifstream file;
-  FunctionArgument::open(file, name, arguments);
+  // parse the descriptor only on the first call with this signature
+  auto key = FunctionArgument::get_filename(name, arguments);
+  auto it = functions.find(key);
+  if (it == functions.end())
+    it = functions.insert({key, FunctionDescriptor(name, arguments)}).first;
+  auto& function = it->second;
 
-  string progname, return_type;
-  int tape_number, return_reg;
-  file >> progname >> tape_number >> return_type >> return_reg;
+  result.check_type(function.return_type);
 
-  result.check_type(return_type);
+  // keep tapes and threads with their preprocessing between calls
+  if (progs.empty() or threads.empty() or progname != function.progname)
+    prepare(function.progname);
 
-  vector<int> arg_regs(arguments.size());
-  vector<int> address_regs(arguments.size());
-  for (size_t i = 0; i < arguments.size(); i++)
-    {
-      file >> arg_regs.at(i);
-      if (arguments[i].get_memory())
-        file >> address_regs.at(i);
-    }
+  return function;
+}
 
-  if (not file.good())
-    throw runtime_error("error reading file for function " + name);
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::run_function(const string& name,
+        FunctionArgument& result, vector<FunctionArgument>& arguments)
+{
+  auto& function = prepare_function(name, result, arguments);
+  auto& arg_regs = function.arg_regs;
+  auto& address_regs = function.address_regs;
+  int tape_number = function.tape_number;
+  int return_reg = function.return_reg;
 
-  prepare(progname);
   auto& processor = *tinfo.at(0).processor;
   processor.reset(progs.at(tape_number), 0);
 
@@ -535,6 +582,8 @@ pair<DataPositions, NamedCommStats> Machine<sint, sgf2n>::stop_threads()
       total.print();
       queues.print_breakdown();
     }
+  else
+    queues.output_profile();
 
   for (auto& queue : queues)
     if (queue)
@@ -43,6 +43,21 @@ public:
   virtual T& at(size_t i) = 0;
   virtual const T& at(size_t i) const = 0;
 
+  // announce access for backends with paging
+  virtual void access(size_t, size_t) {}
+  virtual bool paged() const { return false; }
+  template<class U>
+  void access_indices(U begin, size_t n);
+
+  // contiguous range for vectorized instructions
+  T* range(size_t i, size_t n)
+    {
+      if (n)
+        check_index(i + n - 1);
+      access(i, n);
+      return data() + i;
+    }
+
   template<class U>
   void indirect_read(const Instruction& inst, StackedVector<T>& regs,
       const U& indices);
@@ -100,6 +115,21 @@ public:
     }
 };
 
+template<class T>
+class DiskMemoryPart : public MemoryPartImpl<T, DiskVector>
+{
+public:
+  void access(size_t i, size_t n)
+    {
+      DiskVector<T>::access(i, n);
+    }
+
+  bool paged() const
+    {
+      return true;
+    }
+};
+
 template<class T> 
 class Memory
 {
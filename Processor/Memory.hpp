@@ -16,6 +16,7 @@ void MemoryPart<T>::indirect_read(const Instruction& inst,
   assert(dest + n <= regs.end());
   size_t size = this->size();
 #endif
+  this->access_indices(start, n);
   const T* data = this->data();
   for (auto it = start; it < start + n; it++)
     {
@@ -40,6 +41,7 @@ void MemoryPart<T>::indirect_write(const Instruction& inst,
   assert(source + n <= regs.end());
   size_t size = this->size();
 #endif
+  this->access_indices(start, n);
   T* data = this->data();
   for (auto it = start; it < start + n; it++)
     {
@@ -51,6 +53,25 @@ void MemoryPart<T>::indirect_write(const Instruction& inst,
     }
 }
 
+template<class T>
+template<class U>
+void MemoryPart<T>::access_indices(U begin, size_t n)
+{
+  if (not paged())
+    return;
+
+  // announce runs of consecutive addresses at once
+  auto end = begin + n;
+  for (auto it = begin; it < end;)
+    {
+      auto run_end = it + 1;
+      while (run_end < end and run_end->get() == (run_end - 1)->get() + 1)
+        run_end++;
+      access(it->get(), run_end - it);
+      it = run_end;
+    }
+}
+
 template<class T>
 void Memory<T>::minimum_size(RegType secret_type, RegType clear_type,
     const Program &program, const string& threadname)
@@ -81,7 +102,7 @@ template<class T>
 Memory<T>::Memory() :
     MS(
         *(OnlineOptions::singleton.disk_memory.size() ?
-            static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, DiskVector>) :
+            static_cast<MemoryPart<T>*>(new DiskMemoryPart<T>) :
             static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, CheckVector>)))
 {
 }
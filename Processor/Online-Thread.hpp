@@ -246,20 +246,26 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
         }
       else if (job.type == FFT_JOB)
         {
-          for (int i = job.begin; i < job.end; i++)
-            FFT_Iter2_body(*(vector<modp>*) job.output,
-                *(vector<modp>*) job.input, i, job.length,
-                *(Zp_Data*) job.supply);
+          WorkStealing::run(job, [](const ThreadJob& task) {
+            for (int i = task.begin; i < task.end; i++)
+              FFT_Iter2_body(*(vector<modp>*) task.output,
+                  *(vector<modp>*) task.input, i, task.length,
+                  *(Zp_Data*) task.supply);
+          });
           queues->finished(job);
         }
       else if (job.type == CIPHER_PLAIN_MULT_JOB)
         {
-          cipher_plain_mult(job, sint::triple_matmul);
+          WorkStealing::run(job, [](const ThreadJob& task) {
+            cipher_plain_mult(task, sint::triple_matmul);
+          });
           queues->finished(job);
         }
       else if (job.type == MATRX_RAND_MULT_JOB)
         {
-          matrix_rand_mult(job, sint::triple_matmul);
+          WorkStealing::run(job, [](const ThreadJob& task) {
+            matrix_rand_mult(task, sint::triple_matmul);
+          });
           queues->finished(job);
         }
       else
@@ -350,6 +356,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 
   // wind down thread by thread
   machine.stats += Proc.stats;
+  queues->profile = Proc.profile;
   queues->timers["wait"] = wait_timer + queues->wait_timer;
   timer.stop(P.total_comm());
   queues->timers["online"] = online_timer - online_prep_timer - queues->wait_timer;
@@ -39,7 +39,13 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     opening_sum = 0;
     max_broadcast = 0;
     receive_threads = false;
+    disk_memory_cache = 1024;
     code_locations = false;
+    n_stripes = 1;
+    matrix_threads = 1;
+    prep_low = 10000;
+    prep_high = 100000;
+    central_prep = false;
 #ifdef VERBOSE
     verbose = true;
 #else
@@ -133,6 +139,33 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "Output code locations of the most relevant protocols used", // Help description.
             "--code-locations" // Flag token.
     );
+    opt.add(
+            "1", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Number of connections per pair of parties to split "
+            "large messages across (default: 1)", // Help description.
+            "--stripes" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Write time and communication by instruction to file, "
+            "as CSV if the name ends in .csv and as JSON otherwise", // Help description.
+            "--profile" // Flag token.
+    );
+    opt.add(
+            "1", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Number of threads for local matrix products within "
+            "an instruction (default: 1)", // Help description.
+            "--matrix-threads" // Flag token.
+    );
 
     if (security)
         opt.add(
@@ -163,6 +196,15 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
 
     code_locations = opt.isSet("--code-locations");
 
+    opt.get("--stripes")->getInt(n_stripes);
+    opt.get("--profile")->getString(profile_file);
+    opt.get("--matrix-threads")->getInt(matrix_threads);
+    if (n_stripes < 1)
+    {
+        cerr << "Invalid number of stripes: " << n_stripes << endl;
+        exit(1);
+    }
+
 #ifdef THROW_EXCEPTIONS
     options.push_back("throw_exceptions");
 #endif
@@ -256,6 +298,35 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-b", // Flag token.
             "--batch-size" // Flag token.
     );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            -1, // Number of args expected.
+            ',', // Delimiter if expecting multiple args.
+            "Generate preprocessing in background threads with separate "
+            "communication, comma-separated list of triples|squares|bits", // Help description.
+            "--prep-threads" // Flag token.
+    );
+    opt.add(
+            (to_string(prep_low) + "," + to_string(prep_high)).c_str(), // Default.
+            0, // Required?
+            2, // Number of args expected.
+            ',', // Delimiter if expecting multiple args.
+            ("Number of tuples per type for background threads to keep "
+                    "ready, resume below low and pause above high (default: "
+                    + to_string(prep_low) + "," + to_string(prep_high)
+                    + ")").c_str(), // Help description.
+            "--prep-watermarks" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Generate all preprocessing for threads started together "
+            "centrally in one batch per type", // Help description.
+            "--central-prep" // Flag token.
+    );
     opt.add(
             memtype.c_str(), // Default.
             0, // Required?
@@ -307,6 +378,18 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
         file_prep_per_thread = true;
     }
     opt.get("-b")->getInt(batch_size);
+    opt.get("--prep-threads")->getStrings(prep_threads);
+    vector<long> watermarks;
+    opt.get("--prep-watermarks")->getLongs(watermarks);
+    if (watermarks.size() != 2 or watermarks[0] < 0
+            or watermarks[1] <= watermarks[0])
+    {
+        cerr << "Invalid watermarks for background preprocessing" << endl;
+        exit(1);
+    }
+    prep_low = watermarks[0];
+    prep_high = watermarks[1];
+    central_prep = opt.isSet("--central-prep");
     opt.get("--memory")->getString(memtype);
     bits_from_squares = opt.isSet("-Q");
 
@@ -462,6 +545,16 @@ void OnlineOptions::finalize_with_error(ez::ezOptionParser& opt)
     if (o)
         o->getString(disk_memory);
 
+    o = opt.get("--disk-memory-cache");
+    if (o)
+    {
+        long cache;
+        o->getLong(cache);
+        if (cache < 1)
+            throw runtime_error("invalid disk memory cache size");
+        disk_memory_cache = cache;
+    }
+
     receive_threads = opt.isSet("--threads");
 
     if (use_security_parameter)
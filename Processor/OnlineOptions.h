@@ -40,10 +40,17 @@ public:
     int opening_sum, max_broadcast;
     bool receive_threads;
     std::string disk_memory;
+    size_t disk_memory_cache;
     vector<long> args;
     vector<string> options;
     string executable;
     bool code_locations;
+    int n_stripes;
+    string profile_file;
+    int matrix_threads;
+    vector<string> prep_threads;
+    size_t prep_low, prep_high;
+    bool central_prep;
 
     OnlineOptions();
     OnlineOptions(ez::ezOptionParser& opt, int argc, const char** argv,
@@ -71,6 +71,16 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
               "--disk-memory" // Flag token.
         );
 
+        opt.add(
+              "1024", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Size of the page cache for disk memory in MB "
+              "(default: 1024)", // Help description.
+              "--disk-memory-cache" // Flag token.
+        );
+
         opt.add(
               to_string(V::default_degree()).c_str(), // Default.
               0, // Required?
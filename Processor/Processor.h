@@ -92,6 +92,11 @@ public:
   void matmulsm_finalize_batch(vector<int>::const_iterator startMatmul, int startI, int startJ,
                                vector<int>::const_iterator endMatmul,
                                int endI, int endJ);
+  // for protocols with local matrix products
+  void matmulsm_local(const MemoryPart<T>& source, const vector<int>& args);
+
+  // dot products of all rows and columns by default
+  void prepare_dotprods(const T* A, const T* B, const array<int, 3>& dims);
 
   void conv2ds(const Instruction& instruction);
 
@@ -602,14 +602,7 @@ void SubProcessor<T>::matmuls(const StackedVector<T>& source,
         assert(A + dim[0] * dim[1] <= source.end());
         assert(B + dim[1] * dim[2] <= source.end());
 
-        for (int i = 0; i < dim[0]; i++)
-            for (int j = 0; j < dim[2]; j++)
-            {
-                for (int k = 0; k < dim[1]; k++)
-                    protocol.prepare_dotprod(*(A + i * dim[1] + k),
-                            *(B + k * dim[2] + j));
-                protocol.next_dotprod();
-            }
+        protocol.prepare_matmul(*this, &*A, &*B, {{dim[0], dim[1], dim[2]}});
     }
 
     protocol.exchange();
@@ -628,12 +621,28 @@ void SubProcessor<T>::matmuls(const StackedVector<T>& source,
 }
 
 
+template<class T>
+void SubProcessor<T>::prepare_dotprods(const T* A, const T* B,
+        const array<int, 3>& dim)
+{
+    for (int i = 0; i < dim[0]; i++)
+        for (int j = 0; j < dim[2]; j++)
+        {
+            for (int k = 0; k < dim[1]; k++)
+                protocol.prepare_dotprod(A[i * dim[1] + k], B[k * dim[2] + j]);
+            protocol.next_dotprod();
+        }
+}
+
 template<class T>
 void SubProcessor<T>::matmulsm(const MemoryPart<T>& source,
         const vector<int>& start)
 {
     assert(Proc);
 
+    if (T::Protocol::local_matmul)
+        return matmulsm_local(source, start);
+
     auto batchStartMatrix = start.begin();
     int batchStartI = 0;
     int batchStartJ = 0;
@@ -703,6 +712,96 @@ void SubProcessor<T>::matmulsm(const MemoryPart<T>& source,
     maybe_check();
 }
 
+/*
+ * Gather rows and columns to run local matrix products on blocks of
+ * rows. Blocks of several matrices are combined in one exchange
+ * up to the batch size.
+ */
+template<class T>
+void SubProcessor<T>::matmulsm_local(const MemoryPart<T>& source,
+        const vector<int>& start)
+{
+    auto& Ci = Proc->get_Ci();
+    size_t batch_size = max(1, OnlineOptions::singleton.batch_size);
+    vector<T> A, B;
+    // matrix arguments and rows waiting for the next exchange
+    vector<tuple<vector<int>::const_iterator, int, int>> pending;
+    size_t n_pending = 0;
+
+    auto finalize = [&]()
+    {
+        protocol.exchange();
+        for (auto& x : pending)
+        {
+            auto args = get<0>(x);
+            auto output = S.begin() + args[0];
+            for (int i = get<1>(x); i < get<2>(x); i++)
+                for (int j = 0; j < args[5]; j++)
+                    *(output + i * args[5] + j) = protocol.finalize_dotprod(
+                            args[4]);
+        }
+        pending.clear();
+        n_pending = 0;
+    };
+
+    protocol.init_dotprod();
+    for (auto args = start.begin(); args < start.end(); args += 12)
+    {
+        size_t first_base = Ci.at(args[1]).get();
+        size_t second_base = Ci.at(args[2]).get();
+        int n_rows = args[3], n_inner = args[4], n_columns = args[5];
+
+        assert(S.begin() + args[0] + n_rows * n_columns <= S.end());
+
+        B.resize(n_inner * n_columns);
+        for (int k = 0; k < n_inner; k++)
+        {
+            size_t row = Ci.at(args[8] + k).get();
+            for (int j = 0; j < n_columns; j++)
+            {
+                size_t address = second_base + row * args[11]
+                        + Ci.at(args[9] + j).get();
+                assert(address < source.size());
+                B[k * n_columns + j] = source.data()[address];
+            }
+        }
+
+        int rows_per_block = max<size_t>(1, batch_size / max(1, n_columns));
+        for (int i_begin = 0; i_begin < n_rows; i_begin += rows_per_block)
+        {
+            int i_end = min(n_rows, i_begin + rows_per_block);
+            A.resize((i_end - i_begin) * n_inner);
+            for (int i = i_begin; i < i_end; i++)
+            {
+                size_t row = Ci.at(args[6] + i).get();
+                for (int k = 0; k < n_inner; k++)
+                {
+                    size_t address = first_base + row * args[10]
+                            + Ci.at(args[7] + k).get();
+                    assert(address < source.size());
+                    A[(i - i_begin) * n_inner + k] = source.data()[address];
+                }
+            }
+
+            protocol.prepare_matmul(*this, A.data(), B.data(),
+                    {{i_end - i_begin, n_inner, n_columns}});
+            pending.push_back({args, i_begin, i_end});
+            n_pending += (i_end - i_begin) * n_columns;
+
+            if (n_pending >= batch_size)
+            {
+                finalize();
+                protocol.init_dotprod();
+            }
+        }
+    }
+
+    if (not pending.empty())
+        finalize();
+
+    maybe_check();
+}
+
 template<class T>
 void SubProcessor<T>::matmulsm_finalize_batch(vector<int>::const_iterator startMatmul, int startI, int startJ,
     vector<int>::const_iterator endMatmul, int endI, int endJ) {
@@ -803,7 +902,10 @@ void SubProcessor<T>::conv2ds(const Instruction& instruction)
         size_t i;
         for (i = done; i < tuples.size() and protocol.get_buffer_size() <
                 OnlineOptions::singleton.batch_size; i++)
-            tuples[i].pre(S, protocol);
+            if (T::Protocol::local_matmul)
+                tuples[i].pre_matmul(*this);
+            else
+                tuples[i].pre(S, protocol);
         protocol.exchange();
         for (; done < i; done++)
             tuples[done].post(S, protocol);
@@ -828,7 +930,6 @@ Conv2dTuple::Conv2dTuple(const vector<int>& arguments, int start)
     r0 = arguments[start];
     r1 = arguments[start + 1];
     r2 = arguments[start + 2];
-    lengths.resize(batch_size, vector<vector<int>>(output_h, vector<int>(output_w)));
     filter_stride_h = 1;
     filter_stride_w = 1;
     if (stride_h < 0)
@@ -843,6 +944,82 @@ Conv2dTuple::Conv2dTuple(const vector<int>& arguments, int start)
     }
 }
 
+inline
+int Conv2dTuple::get_length(int out_y, int out_x)
+{
+    int n_y = 0, n_x = 0;
+    for (int filter_y = 0; filter_y < weights_h; filter_y++)
+    {
+        int in_y = out_y * stride_h - padding_h + filter_y * filter_stride_h;
+        n_y += (0 <= in_y) and (in_y < inputs_h);
+    }
+    for (int filter_x = 0; filter_x < weights_w; filter_x++)
+    {
+        int in_x = out_x * stride_w - padding_w + filter_x * filter_stride_w;
+        n_x += (0 <= in_x) and (in_x < inputs_w);
+    }
+    return n_y * n_x * n_channels_in;
+}
+
+/**
+ * Convolution as product of the weights and a matrix with one column
+ * per output pixel (im2col), which leaves the work to the local
+ * matrix multiplication of the protocol.
+ * Padding results in zero entries, which do not change the result.
+ */
+template<class T>
+void Conv2dTuple::pre_matmul(SubProcessor<T>& processor)
+{
+    auto& S = processor.get_S();
+    int n_inner = weights_h * weights_w * n_channels_in;
+    int n_outputs = output_h * output_w;
+    assert(size_t(r2 + n_inner) <= S.size());
+    vector<T> columns(size_t(n_inner) * n_outputs);
+    int n_threads = OnlineOptions::singleton.matrix_threads;
+
+    for (int i_batch = 0; i_batch < batch_size; i_batch ++)
+    {
+        size_t base = r1 + i_batch * inputs_w * inputs_h * n_channels_in;
+        assert(base + inputs_w * inputs_h * n_channels_in <= S.size());
+        T* input_base = &S[base];
+
+#pragma omp parallel for num_threads(n_threads) if(n_threads > 1 and output_h > 1)
+        for (int out_y = 0; out_y < output_h; out_y++)
+            for (int out_x = 0; out_x < output_w; out_x++)
+            {
+                int in_x_origin = (out_x * stride_w) - padding_w;
+                int in_y_origin = (out_y * stride_h) - padding_h;
+                T* column = &columns[out_y * output_w + out_x];
+
+                for (int filter_y = 0; filter_y < weights_h; filter_y++)
+                {
+                    int in_y = in_y_origin + filter_y * filter_stride_h;
+                    for (int filter_x = 0; filter_x < weights_w; filter_x++)
+                    {
+                        int in_x = in_x_origin + filter_x * filter_stride_w;
+                        size_t row = (filter_y * weights_w + filter_x)
+                                * n_channels_in;
+                        if ((0 <= in_y) and (in_y < inputs_h) and (0 <= in_x)
+                                and (in_x < inputs_w))
+                        {
+                            T* pixel_base = &input_base[(in_y * inputs_w
+                                    + in_x) * n_channels_in];
+                            for (int in_c = 0; in_c < n_channels_in; in_c++)
+                                column[(row + in_c) * n_outputs] =
+                                        pixel_base[in_c];
+                        }
+                        else
+                            for (int in_c = 0; in_c < n_channels_in; in_c++)
+                                column[(row + in_c) * n_outputs] = {};
+                    }
+                }
+            }
+
+        processor.protocol.prepare_matmul(processor, &S[r2], columns.data(),
+                {{1, n_inner, n_outputs}});
+    }
+}
+
 template<class T>
 void Conv2dTuple::pre(StackedVector<T>& S, typename T::Protocol& protocol)
 {
@@ -874,7 +1051,6 @@ void Conv2dTuple::pre(StackedVector<T>& S, typename T::Protocol& protocol)
                                 for (int in_c = 0; in_c < n_channels_in; in_c++)
                                     protocol.prepare_dotprod(pixel_base[in_c],
                                             weight_base[in_c]);
-                                lengths[i_batch][out_y][out_x] += n_channels_in;
                             }
                         }
                 }
@@ -896,8 +1072,7 @@ void Conv2dTuple::post(StackedVector<T>& S, typename T::Protocol& protocol)
             for (int out_x = 0; out_x < output_w; out_x++)
             {
                 output_base[out_y * output_w + out_x] =
-                        protocol.finalize_dotprod(
-                                lengths[i_batch][out_y][out_x]);
+                        protocol.finalize_dotprod(get_length(out_y, out_x));
             }
     }
 }
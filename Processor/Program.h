@@ -61,6 +61,9 @@ class Program
   const string& get_hash() const
     { return hash; }
 
+  const string& get_name() const
+    { return name; }
+
   friend ostream& operator<<(ostream& s,const Program& P);
 
   // Execute this program, updateing the processor and memory
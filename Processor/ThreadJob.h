@@ -9,6 +9,8 @@
 #include "Data_Files.h"
 #include "Math/modp.h"
 
+class WorkStealing;
+
 enum ThreadJobType
 {
     TAPE_JOB,
@@ -45,10 +47,12 @@ public:
     const void* input;
     int begin, end, length;
     const void* supply;
+    // tasks to take instead of [begin, end) if set
+    WorkStealing* tasks;
 
     ThreadJob() :
             type(NO_JOB), prognum(0), arg(0), output(0), output2(0), input(0),
-            begin(0), end(0), length(0), supply(0)
+            begin(0), end(0), length(0), supply(0), tasks(0)
     {
     }
 
@@ -8,6 +8,7 @@
 
 #include "ThreadJob.h"
 #include "Tools/NamedStats.h"
+#include "Tools/ExecutionProfile.h"
 
 class ThreadQueue
 {
@@ -22,9 +23,14 @@ public:
     map<string, TimerWithComm> timers;
     Timer wait_timer;
     NamedStats stats;
+    ExecutionProfile profile;
+
+    // work stealing
+    Timer task_timer;
+    long n_tasks, n_stolen;
 
     ThreadQueue() :
-            left(0)
+            left(0), n_tasks(0), n_stolen(0)
     {
     }
 
@@ -4,6 +4,7 @@
  */
 
 #include "ThreadQueues.h"
+#include "OnlineOptions.h"
 
 #include <assert.h>
 #include <math.h>
@@ -116,9 +117,44 @@ void ThreadQueues::print_breakdown()
         if (sum("random").elapsed())
             cerr << "Spent " << sum("random").full()
                     << " on correlated randomness generation." << endl;
+
+        if (size() > 1)
+            print_utilization();
+    }
+
+    output_profile();
+}
+
+void ThreadQueues::print_utilization()
+{
+    for (size_t i = 0; i < size(); i++)
+    {
+        auto queue = at(i);
+        double busy = queue->timers["online"].elapsed()
+                + queue->timers["prep"].elapsed();
+        double total = busy + queue->timers["wait"].elapsed();
+        cerr << "Thread " << i << " busy " << busy << " seconds";
+        if (total > 0)
+            cerr << " (" << 100 * busy / total << "%)";
+        if (queue->n_tasks)
+            cerr << ", " << queue->n_tasks << " shared tasks in "
+                    << queue->task_timer.elapsed() << " seconds ("
+                    << queue->n_stolen << " stolen)";
+        cerr << endl;
     }
 }
 
+void ThreadQueues::output_profile()
+{
+    if (not ExecutionProfile::active())
+        return;
+
+    ExecutionProfile profile;
+    for (auto& queue : *this)
+        profile += queue->profile;
+    profile.output(OnlineOptions::singleton.profile_file);
+}
+
 NamedCommStats ThreadQueues::total_comm()
 {
     NamedCommStats res;
@@ -9,6 +9,7 @@
 #include "Tools/WaitQueue.h"
 #include "ThreadJob.h"
 #include "ThreadQueue.h"
+#include "WorkStealing.h"
 
 class ThreadQueues :
         public vector<ThreadQueue*>
@@ -24,13 +25,44 @@ public:
     int distribute_no_setup(ThreadJob job, int n_items, int base = 0,
             int granularity = 1, const vector<void*>* supplies = 0);
     void wrap_up(ThreadJob job);
+    // runs body on ranges in all threads including the calling one,
+    // only for jobs without communication
+    template<class T>
+    void distribute_stealing(ThreadJob job, int n_items, const T& body,
+            int granularity = 1);
 
     TimerWithComm sum(const string& phase);
 
     void print_breakdown();
+    void print_utilization();
+    // merge profiles of all threads and write to file if requested
+    void output_profile();
 
     NamedCommStats total_comm();
     NamedCommStats max_comm();
 };
 
+template<class T>
+void ThreadQueues::distribute_stealing(ThreadJob job, int n_items,
+        const T& body, int granularity)
+{
+    if (find_available() == 0)
+    {
+        job.begin = 0;
+        job.end = n_items;
+        body(job);
+        return;
+    }
+
+    // the caller is thread 0 as in find_available()
+    vector<int> thread_nums = {0};
+    thread_nums.insert(thread_nums.end(), available.begin(), available.end());
+    WorkStealing tasks(thread_nums, 0, n_items, granularity);
+    job.tasks = &tasks;
+    for (int i : available)
+        at(i)->schedule(job);
+    WorkStealing::run(job, body);
+    wrap_up(job);
+}
+
 #endif /* PROCESSOR_THREADQUEUES_H_ */
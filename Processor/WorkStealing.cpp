@@ -0,0 +1,85 @@
+/*
+ * WorkStealing.cpp
+ *
+ */
+
+#include "WorkStealing.h"
+#include "ThreadQueue.h"
+#include "BaseMachine.h"
+#include "Tools/int.h"
+
+#include <algorithm>
+
+WorkStealing::WorkStealing(const vector<int>& thread_nums, int begin,
+        int end, int granularity) :
+        thread_nums(thread_nums), tasks(thread_nums.size())
+{
+    assert(granularity > 0);
+    int n_tasks = thread_nums.size() * TASKS_PER_THREAD;
+    int task_size = DIV_CEIL(DIV_CEIL(end - begin, n_tasks), granularity)
+            * granularity;
+    task_size = max(task_size, granularity);
+    n_tasks = DIV_CEIL(end - begin, task_size);
+
+    // contiguous blocks to start with
+    for (int i = 0; i < n_tasks; i++)
+    {
+        int task_begin = begin + i * task_size;
+        tasks[i * thread_nums.size() / n_tasks].ranges.push_back(
+                {{task_begin, min(end, task_begin + task_size)}});
+    }
+}
+
+bool WorkStealing::pop(int i, array<int, 2>& range, bool front)
+{
+    auto& mine = tasks.at(i);
+    ScopeLock _(mine.lock);
+    if (mine.ranges.empty())
+        return false;
+    if (front)
+    {
+        range = mine.ranges.front();
+        mine.ranges.pop_front();
+    }
+    else
+    {
+        range = mine.ranges.back();
+        mine.ranges.pop_back();
+    }
+    return true;
+}
+
+bool WorkStealing::next(ThreadJob& task)
+{
+    auto queue = ThreadQueue::thread_queue;
+    if (queue and queue->task_timer.is_running())
+        queue->task_timer.stop();
+
+    auto me = find(thread_nums.begin(), thread_nums.end(),
+            BaseMachine::thread_num) - thread_nums.begin();
+    assert(me < (long) thread_nums.size());
+
+    array<int, 2> range;
+    bool stolen = false;
+    if (not pop(me, range, true))
+    {
+        stolen = true;
+        int n = thread_nums.size();
+        int i;
+        for (i = 1; i < n; i++)
+            if (pop((me + i) % n, range, false))
+                break;
+        if (i == n)
+            return false;
+    }
+
+    task.begin = range[0];
+    task.end = range[1];
+    if (queue)
+    {
+        queue->n_tasks++;
+        queue->n_stolen += stolen;
+        queue->task_timer.start();
+    }
+    return true;
+}
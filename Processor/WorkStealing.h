@@ -0,0 +1,62 @@
+/*
+ * WorkStealing.h
+ *
+ */
+
+#ifndef PROCESSOR_WORKSTEALING_H_
+#define PROCESSOR_WORKSTEALING_H_
+
+#include "ThreadJob.h"
+#include "Tools/Lock.h"
+
+#include <deque>
+#include <array>
+using namespace std;
+
+/*
+ * Splits a job into granularity-aligned tasks on per-thread deques.
+ * A thread takes tasks from the front of its own deque and then steals
+ * from the back of the others.
+ * This is only safe for jobs without communication because the parties
+ * would otherwise disagree on which thread processes which items.
+ */
+class WorkStealing
+{
+    struct Tasks
+    {
+        Lock lock;
+        deque<array<int, 2>> ranges;
+    };
+
+    vector<int> thread_nums;
+    deque<Tasks> tasks;
+
+    bool pop(int i, array<int, 2>& range, bool front);
+
+public:
+    static const int TASKS_PER_THREAD = 8;
+
+    // run body on the job's range or all tasks the thread can get
+    template<class T>
+    static void run(ThreadJob& job, const T& body);
+
+    WorkStealing(const vector<int>& thread_nums, int begin, int end,
+            int granularity);
+
+    bool next(ThreadJob& task);
+};
+
+template<class T>
+void WorkStealing::run(ThreadJob& job, const T& body)
+{
+    if (job.tasks)
+    {
+        ThreadJob task = job;
+        while (job.tasks->next(task))
+            body(task);
+    }
+    else
+        body(job);
+}
+
+#endif /* PROCESSOR_WORKSTEALING_H_ */
@@ -14,9 +14,9 @@
     X(LDSI, auto dest = &Procp.get_S()[r[0]]; \
             auto tmp = sint::constant(int(n), Proc.P.my_num(), Procp.MC.get_alphai()), \
             *dest++ = tmp) \
-    X(LDMS, auto dest = &Procp.get_S()[r[0]]; auto source = &Proc.machine.Mp.MS[n], \
+    X(LDMS, auto dest = &Procp.get_S()[r[0]]; auto source = Proc.machine.Mp.MS.range(n, size), \
             *dest++ = *source++) \
-    X(STMS, auto source = &Procp.get_S()[r[0]]; auto dest = &Proc.machine.Mp.MS[n], \
+    X(STMS, auto source = &Procp.get_S()[r[0]]; auto dest = Proc.machine.Mp.MS.range(n, size), \
             *dest++ = *source++) \
     X(LDMSI, Proc.machine.Mp.MS.indirect_read(instruction, Procp.get_S(), Proc.get_Ci()),) \
     X(STMSI, Proc.machine.Mp.MS.indirect_write(instruction, Procp.get_S(), Proc.get_Ci()),) \
@@ -117,9 +117,9 @@
     X(GLDSI, auto dest = &Proc2.get_S()[r[0]]; \
             auto tmp = sgf2n::constant(int(n), Proc.P.my_num(), Proc2.MC.get_alphai()), \
             *dest++ = tmp) \
-    X(GLDMS, auto dest = &Proc2.get_S()[r[0]]; auto source = &Proc.machine.M2.MS[n], \
+    X(GLDMS, auto dest = &Proc2.get_S()[r[0]]; auto source = Proc.machine.M2.MS.range(n, size), \
             *dest++ = *source++) \
-    X(GSTMS, auto source = &Proc2.get_S()[r[0]]; auto dest = &Proc.machine.M2.MS[n], \
+    X(GSTMS, auto source = &Proc2.get_S()[r[0]]; auto dest = Proc.machine.M2.MS.range(n, size), \
             *dest++ = *source++) \
     X(GLDMSI, Proc.machine.M2.MS.indirect_read(instruction, Proc2.get_S(), Proc.get_Ci()),) \
     X(GSTMSI, Proc.machine.M2.MS.indirect_write(instruction, Proc2.get_S(), Proc.get_Ci()),) \
@@ -7,6 +7,7 @@
 #define PROTOCOLS_ASTRA_H_
 
 #include "Replicated.h"
+#include "Tools/SharedRing.h"
 
 template<class T> class TrioPrepShare;
 template<class T> class AstraPrepShare;
@@ -35,6 +36,9 @@ protected:
     string get_filename(bool create, const char* name = "Protocol");
     string get_output_filename();
 
+    // shared memory instead of files or named pipes
+    static bool use_shared_memory();
+
     void debug();
 
     virtual int my_astra_num() = 0;
@@ -104,6 +108,7 @@ class AstraOnlineBase : public AstraBase<T>
 protected:
     ifstream prep;
     ofstream outputs;
+    SharedRing prep_ring, output_ring;
     int astra_num;
 
     octetStream cs_prep;
@@ -223,6 +228,7 @@ class AstraPrepProtocol : public AstraBase<T>
 protected:
     ofstream prep;
     ifstream outputs;
+    SharedRing prep_ring, output_ring;
     ReplicatedBase prng_protocol;
     ReplicatedBase prng_protocol_for_input0;
     int my_num;
@@ -29,6 +29,12 @@ string AstraBase<T>::get_output_filename()
     return get_filename(not T::real_shares(P), "Outputs");
 }
 
+template<class T>
+bool AstraBase<T>::use_shared_memory()
+{
+    return OnlineOptions::singleton.has_option("astra_shm");
+}
+
 template<class T>
 void AstraBase<T>::debug()
 {
@@ -88,14 +94,22 @@ AstraPrepProtocol<T>::~AstraPrepProtocol()
 template<class T>
 void AstraOnlineBase<T>::init_prep()
 {
-    open_with_check(prep, this->get_filename(false));
+    if (this->use_shared_memory())
+        prep_ring.open(this->get_filename(false), true);
+    else
+        open_with_check(prep, this->get_filename(false));
 }
 
 template<class T>
 void AstraPrepProtocol<T>::init_prep()
 {
     if (this->P.my_num() > 0)
-        prep.open(this->get_filename(true));
+    {
+        if (this->use_shared_memory())
+            prep_ring.open(this->get_filename(true), false);
+        else
+            prep.open(this->get_filename(true));
+    }
 }
 
 template<class T>
@@ -389,14 +403,19 @@ U AstraOnlineBase<T>::read()
 template<class T>
 void AstraOnlineBase<T>::read(octetStream& os)
 {
-    if (not prep.is_open())
+    if (not prep.is_open() and not prep_ring.is_open())
         init_prep();
     Timer timer;
     TimeScope ts(timer);
     this->debug();
-    os.input(prep);
-    if (not prep.good())
-        throw runtime_error("error in preprocessing reading");
+    if (prep_ring.is_open())
+        prep_ring.receive(os);
+    else
+    {
+        os.input(prep);
+        if (not prep.good())
+            throw runtime_error("error in preprocessing reading");
+    }
     this->P.comm_stats["Preprocessing transmission"].add(os, ts);
 }
 
@@ -417,14 +436,19 @@ void AstraPrepProtocol<T>::store(const octetStream& os)
 {
     if (this->P.my_num() > 0)
     {
-        if (not prep.is_open())
+        if (not prep.is_open() and not prep_ring.is_open())
             init_prep();
         TimeScope ts(this->P.comm_stats["Preprocessing transmission"].add(os));
         this->debug();
-        os.output(prep);
-        prep.flush();
-        if (not prep.good())
-            throw runtime_error("error in preprocessing storing");
+        if (prep_ring.is_open())
+            prep_ring.send(os);
+        else
+        {
+            os.output(prep);
+            prep.flush();
+            if (not prep.good())
+                throw runtime_error("error in preprocessing storing");
+        }
     }
 }
 
@@ -434,13 +458,19 @@ void AstraPrepProtocol<T>::sync(vector<U>& values, Player& P)
 {
     if (P.my_num() == 1)
     {
-        if (not outputs.is_open())
+        bool shm = this->use_shared_memory();
+        if (shm and not output_ring.is_open())
+            output_ring.open(this->get_output_filename(), true);
+        else if (not shm and not outputs.is_open())
             open_with_check(outputs, this->get_output_filename());
 
         Timer timer;
         TimeScope ts(timer);
         octetStream os;
-        os.input(outputs);
+        if (shm)
+            output_ring.receive(os);
+        else
+            os.input(outputs);
         os.get(values);
         this->P.comm_stats["Output transmission"].add(os, ts);
         P.send_all(os);
@@ -459,14 +489,22 @@ void AstraOnlineBase<T>::sync(vector<U>& values, Player& P)
 {
     if (P.my_num() == 0)
     {
-        if (not outputs.is_open())
+        bool shm = this->use_shared_memory();
+        if (shm and not output_ring.is_open())
+            output_ring.open(this->get_output_filename(), false);
+        else if (not shm and not outputs.is_open())
             outputs.open(this->get_output_filename());
 
         octetStream os;
         os.store(values);
         TimeScope ts(this->P.comm_stats["Output transmission"].add(os));
-        os.output(outputs);
-        outputs.flush();
+        if (shm)
+            output_ring.send(os);
+        else
+        {
+            os.output(outputs);
+            outputs.flush();
+        }
     }
 }
 
@@ -29,11 +29,13 @@ protected:
     vector<typename T::open_type> opened;
     vector<array<T, 3>> triples;
     vector<int> lengths;
-    typename vector<typename T::open_type>::iterator it;
-    typename vector<array<T, 3>>::iterator triple;
+    vector<T> results;
+    typename vector<T>::iterator result;
     Preprocessing<T>* prep;
     typename T::MAC_Check* MC;
 
+    void finalize_all();
+
 public:
     static const bool uses_triples = true;
 
@@ -12,6 +12,106 @@
 
 #include <array>
 
+template<class T> class SemiShare;
+template<class T> class Share;
+
+template<class T, class U>
+void beaver_finalize(vector<T>& results, const vector<array<T, 3>>& triples,
+        const vector<typename T::open_type>& opened, int my_num,
+        const U& alphai)
+{
+    results.clear();
+    results.reserve(triples.size());
+    for (size_t i = 0; i < triples.size(); i++)
+    {
+        auto masked = &opened[2 * i];
+        auto& triple = triples[i];
+        T tmp = triple[2];
+        tmp += (masked[0] * triple[1]);
+        tmp += (triple[0] * masked[1]);
+        tmp += T::constant(masked[0] * masked[1], my_num, alphai);
+        results.push_back(tmp);
+    }
+}
+
+/*
+ * Batched version for prime field shares, with the a, b, and c parts
+ * of the triples at a stride in field elements.
+ */
+template<class V>
+void beaver_finalize_part(V* res, const V* a, const V* b, const V* c,
+        size_t stride, const vector<V>& opened, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        res[i] = c[i * stride];
+    V::mul_add_many(res, opened.data(), b, n, 1, 2, stride);
+    V::mul_add_many(res, opened.data() + 1, a, n, 1, 2, stride);
+}
+
+template<int X, int L, class U>
+void beaver_finalize(vector<SemiShare<gfp_<X, L>>>& results,
+        const vector<array<SemiShare<gfp_<X, L>>, 3>>& triples,
+        const vector<gfp_<X, L>>& opened, int my_num, const U&)
+{
+    typedef gfp_<X, L> V;
+    size_t n = triples.size();
+    results.clear();
+    if (n == 0)
+        return;
+    size_t stride = sizeof(triples[0]) / sizeof(V);
+    assert(sizeof(triples[0]) == 3 * sizeof(V));
+    vector<V> res(n), products(n);
+    beaver_finalize_part<V>(res.data(), (const V*) &triples[0][0],
+            (const V*) &triples[0][1], (const V*) &triples[0][2], stride,
+            opened, n);
+    if (my_num == 0)
+    {
+        V::mul_many(products.data(), opened.data(), opened.data() + 1, n, 1,
+                2, 2);
+        V::add_many(res.data(), res.data(), products.data(), n);
+    }
+    results.assign(res.begin(), res.end());
+}
+
+template<int X, int L>
+void beaver_finalize(vector<Share<gfp_<X, L>>>& results,
+        const vector<array<Share<gfp_<X, L>>, 3>>& triples,
+        const vector<gfp_<X, L>>& opened, int my_num,
+        const gfp_<X, L>& alphai)
+{
+    typedef gfp_<X, L> V;
+    size_t n = triples.size();
+    results.clear();
+    if (n == 0)
+        return;
+    // shares and MACs are not evenly spaced in general
+    vector<V> parts[2][3];
+    for (auto& x : parts)
+        for (auto& y : x)
+            y.resize(n);
+    for (size_t i = 0; i < n; i++)
+        for (int j = 0; j < 3; j++)
+        {
+            parts[0][j][i] = triples[i][j].get_share();
+            parts[1][j][i] = triples[i][j].get_mac();
+        }
+    vector<V> shares(n), macs(n), products(n);
+    beaver_finalize_part<V>(shares.data(), parts[0][0].data(),
+            parts[0][1].data(), parts[0][2].data(), 1, opened, n);
+    beaver_finalize_part<V>(macs.data(), parts[1][0].data(),
+            parts[1][1].data(), parts[1][2].data(), 1, opened, n);
+    V::mul_many(products.data(), opened.data(), opened.data() + 1, n, 1, 2, 2);
+    if (my_num == 0)
+        V::add_many(shares.data(), shares.data(), products.data(), n);
+    V::mul_add_many(macs.data(), products.data(), &alphai, n, 1, 1, 0);
+    results.resize(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        results[i].set_share(shares[i]);
+        results[i].set_mac(macs[i]);
+    }
+}
+
 template<class T>
 typename T::Protocol Beaver<T>::branch()
 {
@@ -38,6 +138,7 @@ void Beaver<T>::init_mul()
     opened.clear();
     triples.clear();
     lengths.clear();
+    results.clear();
 }
 
 template<class T>
@@ -63,8 +164,7 @@ void Beaver<T>::exchange()
     MC->exchange(P);
     for (size_t i = 0; i < shares.size(); i++)
         opened.push_back(MC->finalize_raw());
-    it = opened.begin();
-    triple = triples.begin();
+    finalize_all();
 }
 
 template<class T>
@@ -77,25 +177,21 @@ template<class T>
 void Beaver<T>::stop_exchange()
 {
     MC->POpen_End(opened, shares, P);
-    it = opened.begin();
-    triple = triples.begin();
+    finalize_all();
+}
+
+template<class T>
+void Beaver<T>::finalize_all()
+{
+    beaver_finalize(results, triples, opened, P.my_num(), MC->get_alphai());
+    result = results.begin();
 }
 
 template<class T>
 T Beaver<T>::finalize_mul(int n)
 {
     this->add_mul(n);
-    typename T::open_type masked[2];
-    T& tmp = (*triple)[2];
-    for (int k = 0; k < 2; k++)
-    {
-        masked[k] = *it++;
-    }
-    tmp += (masked[0] * (*triple)[1]);
-    tmp += ((*triple)[0] * masked[1]);
-    tmp += T::constant(masked[0] * masked[1], P.my_num(), MC->get_alphai());
-    triple++;
-    return tmp;
+    return *result++;
 }
 
 template<class T>
@@ -123,12 +123,9 @@ void HemiMatrixPrep<T>::buffer_triples()
     if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
     {
         auto& queues = BaseMachine::s().queues;
-        int start = queues.distribute(job, n_matrices);
-        job.begin = start;
-        job.end = n_matrices;
-        matrix_rand_mult(job);
-        if (start)
-            queues.wrap_up(job);
+        queues.distribute_stealing(job, n_matrices, [](const ThreadJob& task) {
+            matrix_rand_mult(task);
+        });
     }
     else
     {
@@ -185,15 +182,10 @@ void HemiMatrixPrep<T>::buffer_triples()
                 for (int i = 0; i < n_inner; i++)
                     multiplicands2.push_back(diag.get_plaintext(B, i, j));
                 CipherPlainMultJob job(products, multiplicands, multiplicands2, true);
-                int start = queues.distribute(job, n_inner);
-#ifdef VERBOSE_HE
-                fprintf(stderr, "from %d in central thread at %f\n", start, timer.elapsed());
-                fflush(stderr);
-#endif
-                for (int i = start; i < n_inner; i++)
-                    products[i] = multiplicands.at(i) * multiplicands2.at(i);
-                if (start)
-                    queues.wrap_up(job);
+                queues.distribute_stealing(job, n_inner,
+                        [](const ThreadJob& task) {
+                            cipher_plain_mult(task, true_type());
+                        });
 #ifdef VERBOSE_HE
                 fprintf(stderr, "adding at %f\n", timer.elapsed());
                 fflush(stderr);
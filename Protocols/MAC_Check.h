@@ -220,6 +220,29 @@ public:
 
 enum mc_timer { SEND, RECV_ADD, BCAST, RECV_SUM, SEED, COMMIT, WAIT_SUMMER, RECV, SUM, SELECT, MAX_TIMER };
 
+template<class T>
+void add_packed(vector<T>& values, octetStream& os)
+{
+  if (values.empty())
+    return;
+  T tmp = values[0];
+  for (auto& value : values)
+    {
+      tmp.unpack(os);
+      value += tmp;
+    }
+}
+
+// batched addition for the raw representation
+template<int X, int L>
+void add_packed(vector<gfp_<X, L>>& values, octetStream& os)
+{
+  typedef gfp_<X, L> T;
+  vector<T> tmp(values.size());
+  os.consume((octet*) tmp.data(), tmp.size() * sizeof(T));
+  T::add_many(values.data(), values.data(), tmp.data(), values.size());
+}
+
 template<class T>
 TreeSum<T>::TreeSum(int opening_sum, int max_broadcast, int base_player) :
     base_player(base_player), opening_sum(opening_sum), max_broadcast(max_broadcast)
@@ -299,12 +322,17 @@ void TreeSum<T>::add_openings(vector<T>& values, const Player& P,
       P.wait_receive(sender, oss[j]);
       MC.player_timers[sender].stop();
       MC.timers[SUM].start();
-      T tmp = values.at(0);
-      for (unsigned int i=0; i<values.size(); i++)
+      if (use_lengths)
         {
-          tmp.unpack(oss[j], use_lengths ? lengths[i] : -1);
-          values[i] += tmp;
+          T tmp = values.at(0);
+          for (unsigned int i=0; i<values.size(); i++)
+            {
+              tmp.unpack(oss[j], lengths[i]);
+              values[i] += tmp;
+            }
         }
+      else
+        add_packed(values, oss[j]);
       post_add_process(values);
       MC.timers[SUM].stop();
     }
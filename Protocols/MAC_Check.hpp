@@ -153,6 +153,31 @@ void mac_fail_remove(const Player& P)
   throw mac_fail();
 }
 
+// a = sum of vals[i] * hs[i], gami = sum of hs[i] * macs[i]
+template<class T, class U, class V>
+void random_combination(T& a, T& gami, const vector<U>& hs,
+    const vector<V>& vals, const vector<T>& macs, int n)
+{
+  T temp;
+  for (int i=0; i<n; i++)
+    {
+      temp = vals[i] * hs[i];
+      a = (a + temp);
+
+      temp = hs[i] * macs[i];
+      gami = (gami + temp);
+    }
+}
+
+template<int X, int L>
+void random_combination(gfp_<X, L>& a, gfp_<X, L>& gami,
+    const vector<gfp_<X, L>>& hs, const vector<gfp_<X, L>>& vals,
+    const vector<gfp_<X, L>>& macs, int n)
+{
+  gfp_<X, L>::dot_product(a, hs.data(), vals.data(), n);
+  gfp_<X, L>::dot_product(gami, hs.data(), macs.data(), n);
+}
+
 template<class U>
 void MAC_Check_<U>::Check(const Player& P)
 {
@@ -205,17 +230,11 @@ void MAC_Check_<U>::Check(const Player& P)
 
       U sj;
       typename U::mac_type a,gami,temp;
-      typename U::mac_type::Scalar h;
+      vector<typename U::mac_type::Scalar> hs(popen_cnt);
       vector<typename U::mac_type> tau(P.num_players());
-      for (int i=0; i<popen_cnt; i++)
-        {
-          h.almost_randomize(G);
-          temp = vals[i] * h;
-          a = (a + temp);
-
-          temp = h * macs[i];
-          gami = (gami + temp);
-        }
+      for (auto& h : hs)
+        h.almost_randomize(G);
+      random_combination(a, gami, hs, vals, macs, popen_cnt);
 
       temp = this->alphai * a;
       tau[P.my_num()] = (gami - temp);
@@ -316,10 +335,11 @@ void MAC_Check_Z2k<T, U, V, W>::Check(const Player& P)
   T y, mj;
   y.assign_zero();
   mj.assign_zero();
+  vector<U> chis(this->popen_cnt);
+  G.randomize(chis);
   for (int i = 0; i < this->popen_cnt; ++i)
   {
-    U temp_chi;
-    temp_chi.randomize(G);
+    auto& temp_chi = chis[i];
     T xi = this->vals[i];
     y += xi * temp_chi;
     T mji = this->macs[i];
@@ -373,10 +393,9 @@ void direct_add_openings(vector<T>& values, const PlayerBase& P, vector<octetStr
   size_t n = P.num_players();
   size_t me = P.my_num();
   assert(os.size() == n);
-  for (auto& value : values)
-    for (size_t j = 0; j < n; j++)
-      if (j != me)
-        value += os[j].get<T>();
+  for (size_t j = 0; j < n; j++)
+    if (j != me)
+      add_packed(values, os[j]);
 }
 
 template<class T>
@@ -13,6 +13,8 @@
 
 #include "mac_key.hpp"
 
+template<class T> class MaliciousRep3Share;
+
 template<class T>
 MaliciousBitOnlyRepPrep<T>::MaliciousBitOnlyRepPrep(SubProcessor<T>* proc, DataPositions& usage) :
         BufferPrep<T>(usage),
@@ -109,6 +111,52 @@ void MaliciousRepPrep<T>::buffer_triples()
         triples.push_back({{tuple[0], tuple[2], tuple[3]}});
 }
 
+// res[i] = tuples[i][x] * t - tuples[i][y] - rhos[i] * tuples[i][z]
+template<class T, class U>
+void sacrifice_combine(vector<T>& res, const vector<array<T, 5>>& tuples,
+        int x, int y, const U& t, const vector<typename T::open_type>& rhos,
+        int z)
+{
+    res.clear();
+    res.reserve(tuples.size());
+    for (size_t i = 0; i < tuples.size(); i++)
+    {
+        auto& tuple = tuples[i];
+        res.push_back(T::Mul(tuple[x], t) - tuple[y]);
+        if (not rhos.empty())
+            res.back() = res.back() - rhos[i] * tuple[z];
+    }
+}
+
+// batched version for replicated prime field shares
+template<int X, int L>
+void sacrifice_combine(vector<MaliciousRep3Share<gfp_<X, L>>>& res,
+        const vector<array<MaliciousRep3Share<gfp_<X, L>>, 5>>& tuples,
+        int x, int y, const gfp_<X, L>& t, const vector<gfp_<X, L>>& rhos,
+        int z)
+{
+    typedef gfp_<X, L> V;
+    size_t n = tuples.size();
+    res.resize(n);
+    if (n == 0)
+        return;
+    assert(sizeof(tuples[0]) == 10 * sizeof(V));
+    assert(sizeof(res[0]) == 2 * sizeof(V));
+    vector<V> products(n);
+    for (int k = 0; k < 2; k++)
+    {
+        V* out = &res[0][k];
+        V::mul_many(products.data(), &tuples[0][x][k], &t, n, 1, 10, 0);
+        if (not rhos.empty())
+            V::mul_many(out, rhos.data(), &tuples[0][z][k], n, 2, 1, 10);
+        else
+            for (size_t i = 0; i < n; i++)
+                out[2 * i] = {};
+        V::sub_many(out, products.data(), out, n, 2, 1, 2);
+        V::sub_many(out, out, &tuples[0][y][k], n, 2, 2, 10);
+    }
+}
+
 template<class T, class U>
 void sacrifice(const vector<array<T, 5>>& check_triples, Player& P)
 {
@@ -117,25 +165,12 @@ void sacrifice(const vector<array<T, 5>>& check_triples, Player& P)
     vector<T> masked, checks;
     vector <typename T::open_type> opened;
     typename T::MAC_Check MC;
-    int buffer_size = check_triples.size();
     auto t = Create_Random<U>(P);
-    masked.reserve(buffer_size);
-    for (int i = 0; i < buffer_size; i++)
-    {
-        const T& a = check_triples[i][0];
-        const T& a_prime = check_triples[i][1];
-        masked.push_back(T::Mul(a, t) - a_prime);
-    }
+    // a * t - a'
+    sacrifice_combine(masked, check_triples, 0, 1, t, opened, 2);
     MC.POpen(opened, masked, P);
-    checks.reserve(buffer_size);
-    for (int i = 0; i < buffer_size; i++)
-    {
-        const T& b = check_triples[i][2];
-        const T& c = check_triples[i][3];
-        const T& c_prime = check_triples[i][4];
-        typename T::open_type& rho = opened[i];
-        checks.push_back(T::Mul(c, t) - c_prime - rho * b);
-    }
+    // c * t - c' - rho * b
+    sacrifice_combine(checks, check_triples, 3, 4, t, opened, 2);
     MC.CheckFor(0, checks, P);
     MC.Check(P);
 }
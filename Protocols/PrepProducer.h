@@ -0,0 +1,101 @@
+/*
+ * PrepProducer.h
+ *
+ */
+
+#ifndef PROTOCOLS_PREPPRODUCER_H_
+#define PROTOCOLS_PREPPRODUCER_H_
+
+#include "Processor/Data_Files.h"
+#include "Networking/Player.h"
+#include "Tools/SpscQueue.h"
+#include "Tools/time-func.h"
+
+#include <pthread.h>
+#include <atomic>
+#include <array>
+
+template<class T> class BufferPrep;
+
+/**
+ * Background generation of one tuple type (triples, squares, or bits)
+ * for an instance of ``BufferPrep``. The producer thread keeps
+ * between a low and a high watermark of tuples ready
+ * and hands them over in batches.
+ */
+template<class T>
+class PrepProducer
+{
+    static void* run_thread(void* producer);
+
+    pthread_t thread;
+    bool started;
+
+    Timer stall_timer;
+    size_t n_stalls;
+
+    void start();
+    void pop(vector<T>& batch);
+
+protected:
+    BufferPrep<T>& consumer;
+    Dtype dtype;
+    int thread_num;
+    size_t batch_size, low, high;
+
+    SpscQueue<vector<T>> queue;
+
+    // tuples in the queue
+    atomic<size_t> n_ready;
+    atomic<bool> stopping, failed;
+    string error;
+
+    NamedCommStats comm;
+
+    virtual void run() = 0;
+
+    void push(vector<T>& batch);
+    void stop();
+
+public:
+    PrepProducer(BufferPrep<T>& consumer, Dtype dtype);
+    virtual ~PrepProducer();
+
+    template<size_t N>
+    void pull(vector<array<T, N>>& tuples);
+    void pull(vector<T>& tuples);
+};
+
+/**
+ * Producer running a separate protocol instance
+ * on a dedicated communication channel
+ */
+template<class T>
+class LivePrepProducer : public PrepProducer<T>
+{
+    enum State
+    {
+        PAUSE,
+        PRODUCE,
+        STOP,
+    };
+
+    void run();
+    void produce(typename T::LivePrep& prep, vector<T>& batch);
+
+public:
+    // add producers to live preprocessing as set by --prep-threads
+    static void install(Preprocessing<T>& prep);
+
+    LivePrepProducer(BufferPrep<T>& consumer, Dtype dtype) :
+            PrepProducer<T>(consumer, dtype)
+    {
+    }
+
+    ~LivePrepProducer()
+    {
+        this->stop();
+    }
+};
+
+#endif /* PROTOCOLS_PREPPRODUCER_H_ */
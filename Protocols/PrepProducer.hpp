@@ -0,0 +1,255 @@
+/*
+ * PrepProducer.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_PREPPRODUCER_HPP_
+#define PROTOCOLS_PREPPRODUCER_HPP_
+
+#include "PrepProducer.h"
+#include "ProtocolSet.h"
+#include "Processor/BaseMachine.h"
+#include "Networking/CryptoPlayer.h"
+#include "Tools/Backoff.h"
+#include "Tools/Bundle.h"
+
+template<class T>
+PrepProducer<T>::PrepProducer(BufferPrep<T>& consumer, Dtype dtype) :
+        started(false), n_stalls(0), consumer(consumer), dtype(dtype),
+        thread_num(BaseMachine::thread_num),
+        batch_size(BaseMachine::batch_size<T>(dtype)),
+        low(OnlineOptions::singleton.prep_low),
+        high(max(OnlineOptions::singleton.prep_high, low + batch_size)),
+        queue(DIV_CEIL(high, batch_size) + 2), n_ready(0), stopping(false),
+        failed(false)
+{
+}
+
+template<class T>
+PrepProducer<T>::~PrepProducer()
+{
+    stop();
+}
+
+template<class T>
+void* PrepProducer<T>::run_thread(void* producer)
+{
+    auto& self = *(PrepProducer<T>*) producer;
+    try
+    {
+        self.run();
+    }
+    catch (exception& e)
+    {
+        self.error = e.what();
+        self.failed = true;
+    }
+    return 0;
+}
+
+template<class T>
+void PrepProducer<T>::start()
+{
+    assert(not started);
+    started = true;
+    pthread_create(&thread, 0, run_thread, this);
+}
+
+template<class T>
+void PrepProducer<T>::stop()
+{
+    if (not started)
+        return;
+
+    stopping = true;
+    pthread_join(thread, 0);
+    started = false;
+
+    cerr << "Background " << DataPositions::dtype_names[dtype] << " of "
+            << T::type_string() << ": " << n_stalls << " stalls for "
+            << stall_timer.elapsed() << " seconds, " << comm.sent * 1e-6
+            << " MB sent" << endl;
+}
+
+template<class T>
+void PrepProducer<T>::push(vector<T>& batch)
+{
+    size_t n_tuples = batch.size() / DataPositions::tuple_size[dtype];
+    Backoff backoff;
+    // only full if other parties demand more than the high watermark
+    while (not queue.push(batch))
+    {
+        if (stopping)
+            return;
+        backoff.wait();
+    }
+    n_ready += n_tuples;
+}
+
+template<class T>
+void PrepProducer<T>::pop(vector<T>& batch)
+{
+    // start on first demand to avoid generating unused tuples
+    if (not started)
+        start();
+
+    if (not queue.pop(batch))
+    {
+        TimeScope _(stall_timer);
+        n_stalls++;
+        Backoff backoff;
+        while (not queue.pop(batch))
+        {
+            if (failed)
+                throw runtime_error(
+                        "background preprocessing failed: " + error);
+            backoff.wait();
+        }
+    }
+
+    n_ready -= batch.size() / DataPositions::tuple_size[dtype];
+}
+
+template<class T>
+template<size_t N>
+void PrepProducer<T>::pull(vector<array<T, N>>& tuples)
+{
+    assert(DataPositions::tuple_size[dtype] == N);
+    vector<T> batch;
+    pop(batch);
+    for (size_t i = 0; i < batch.size(); i += N)
+    {
+        tuples.push_back({});
+        for (size_t j = 0; j < N; j++)
+            tuples.back()[j] = batch[i + j];
+    }
+}
+
+template<class T>
+void PrepProducer<T>::pull(vector<T>& tuples)
+{
+    assert(DataPositions::tuple_size[dtype] == 1);
+    vector<T> batch;
+    pop(batch);
+    tuples.insert(tuples.end(), batch.begin(), batch.end());
+}
+
+template<class T>
+void LivePrepProducer<T>::install(Preprocessing<T>& prep)
+{
+    auto& names = OnlineOptions::singleton.prep_threads;
+    if (names.empty())
+        return;
+
+    auto buffer_prep = dynamic_cast<BufferPrep<T>*>(&prep);
+    if (not buffer_prep)
+        return;
+
+    for (auto& name : names)
+    {
+        bool found = false;
+        for (auto dtype : {DATA_TRIPLE, DATA_SQUARE, DATA_BIT})
+        {
+            string dtype_name = DataPositions::dtype_names[dtype];
+            dtype_name[0] = tolower(dtype_name[0]);
+            if (name == dtype_name)
+            {
+                buffer_prep->set_producer(dtype,
+                        new LivePrepProducer<T>(*buffer_prep, dtype));
+                found = true;
+            }
+        }
+        if (not found)
+            throw runtime_error("unknown preprocessing for thread: " + name);
+    }
+}
+
+template<class T>
+void LivePrepProducer<T>::produce(typename T::LivePrep& prep,
+        vector<T>& batch)
+{
+    batch.resize(this->batch_size * DataPositions::tuple_size[this->dtype]);
+    switch (this->dtype)
+    {
+    case DATA_TRIPLE:
+        for (size_t i = 0; i < batch.size(); i += 3)
+            prep.get_three_no_count(DATA_TRIPLE, batch[i], batch[i + 1],
+                    batch[i + 2]);
+        break;
+    case DATA_SQUARE:
+        for (size_t i = 0; i < batch.size(); i += 2)
+            prep.get_two_no_count(DATA_SQUARE, batch[i], batch[i + 1]);
+        break;
+    case DATA_BIT:
+        for (auto& x : batch)
+            prep.get_one_no_count(DATA_BIT, x);
+        break;
+    default:
+        throw not_implemented();
+    }
+}
+
+template<class T>
+void LivePrepProducer<T>::run()
+{
+    bigint::init_thread();
+    BaseMachine::thread_num = this->thread_num;
+
+    auto proc = this->consumer.get_proc();
+    assert(proc);
+    string id = "prep-" + to_string(this->thread_num) + "-"
+            + T::type_short() + "-" + to_string(this->dtype);
+    Player* P;
+    if (proc->P.is_encrypted())
+        P = new CryptoPlayer(proc->P.N, id);
+    else
+        P = new PlainPlayer(proc->P.N, id);
+
+    ProtocolSet<T> set(*P, proc->MC.get_alphai());
+    bool filling = true;
+
+    while (true)
+    {
+        size_t ready = this->n_ready;
+        if (ready <= this->low)
+            filling = true;
+        else if (ready >= this->high)
+            filling = false;
+
+        // all parties have to generate the same batches,
+        // so produce if anyone is below the watermark
+        // and stop if anyone is done
+        Bundle<octetStream> bundle(*P);
+        bundle.mine.store_int(
+                this->stopping ? STOP : (filling ? PRODUCE : PAUSE), 1);
+        P->unchecked_broadcast(bundle);
+        size_t decision = PAUSE;
+        for (auto& os : bundle)
+            decision = max(decision, os.get_int(1));
+
+        if (decision == STOP)
+            break;
+        else if (decision == PRODUCE)
+        {
+            vector<T> batch;
+            produce(set.preprocessing, batch);
+            this->push(batch);
+        }
+        else
+        {
+            // check again after a while in case another party needs more
+            for (int i = 0; i < 100; i++)
+            {
+                if (this->n_ready <= this->low or this->stopping)
+                    break;
+                usleep(100);
+            }
+        }
+    }
+
+    set.check();
+    this->comm = P->total_comm();
+    delete P;
+}
+
+#endif /* PROTOCOLS_PREPPRODUCER_HPP_ */
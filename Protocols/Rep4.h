@@ -62,6 +62,7 @@ class Rep4 : public ProtocolBase<T>
 
 public:
     static const bool uses_triples = false;
+    static const bool local_matmul = true;
 
     prngs_type rep_prngs;
     Player& P;
@@ -83,6 +84,10 @@ public:
     void next_dotprod();
     T finalize_dotprod(int length);
 
+    template<int = 0>
+    void prepare_matmul(SubProcessor<T>& proc, const T* A, const T* B,
+            const array<int, 3>& dims);
+
     T get_random();
     void randoms(T& res, int n_bits);
 
@@ -7,6 +7,7 @@
 #include "GC/square64.h"
 #include "Processor/TruncPrTuple.h"
 #include "Tools/CodeLocations.h"
+#include "Math/Gemm.h"
 
 template<class T>
 Rep4<T>::Rep4(Player& P) :
@@ -243,6 +244,56 @@ void Rep4<T>::next_dotprod()
     dotprod_shares = {};
 }
 
+template<class T>
+template<int>
+void Rep4<T>::prepare_matmul(SubProcessor<T>&, const T* A, const T* B,
+        const array<int, 3>& dims)
+{
+    size_t n = dims[0], m = dims[1], l = dims[2];
+
+    // the terms of get_addshares() as products of
+    // [A[a] | A[b]] and [B[c]; B[d]]
+    auto product = [&](vector<open_type>& res, int a, int b, int c, int d,
+            bool add_next)
+    {
+        vector<open_type> left(n * 2 * m), right(2 * m * l);
+        for (size_t i = 0; i < n; i++)
+            for (size_t k = 0; k < m; k++)
+            {
+                auto& x = A[i * m + k];
+                left[i * 2 * m + k] = x[a];
+                if (add_next)
+                    left[i * 2 * m + k] += x[a + 1];
+                left[i * 2 * m + m + k] = x[b];
+            }
+        for (size_t k = 0; k < m; k++)
+            for (size_t j = 0; j < l; j++)
+            {
+                auto& y = B[k * l + j];
+                right[k * l + j] = y[c];
+                right[(m + k) * l + j] = y[d];
+            }
+        res.resize(n * l);
+        gemm_add(res.data(), left.data(), right.data(), n, 2 * m, l,
+                OnlineOptions::singleton.matrix_threads);
+        for (auto& x : res)
+            x.normalize();
+    };
+
+    array<vector<open_type>, 5> products;
+    for (int i = 0; i < 2; i++)
+        product(products[get_player(i - 1)], i, i, i, i + 1, true);
+    product(products[4], 0, 2, 2, 0, false);
+
+    for (size_t c = 0; c < n * l; c++)
+    {
+        for (int i = 0; i < 5; i++)
+            add_shares[i].push_back(
+                    products[i].empty() ? open_type() : products[i][c]);
+        bit_lengths.push_back(-1);
+    }
+}
+
 template<class T>
 void Rep4<T>::exchange()
 {
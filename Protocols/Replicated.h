@@ -135,6 +135,15 @@ public:
     virtual void randoms(T&, int) { throw runtime_error("randoms not implemented"); }
     virtual void randoms_inst(StackedVector<T>&, const Instruction&);
 
+    /// Whether ``prepare_matmul()`` computes products locally by matrix
+    static const bool local_matmul = false;
+
+    /// Schedule all dot products of a product of row-major matrices
+    template<int = 0>
+    void prepare_matmul(SubProcessor<T>& proc, const T* A, const T* B,
+            const array<int, 3>& dims)
+    { proc.prepare_dotprods(A, B, dims); }
+
     template<int = 0>
     void matmulsm(SubProcessor<T> & proc, MemoryPart<T>& source,
             const Instruction& instruction)
@@ -202,6 +211,7 @@ class Replicated : public ReplicatedBase, public ProtocolBase<T>
 
 public:
     static const bool uses_triples = false;
+    static const bool local_matmul = true;
 
     typedef Rep3Shuffler<T> Shuffler;
 
@@ -231,6 +241,10 @@ public:
     void next_dotprod();
     T finalize_dotprod(int length);
 
+    template<int = 0>
+    void prepare_matmul(SubProcessor<T>& proc, const T* A, const T* B,
+            const array<int, 3>& dims);
+
     template<class U>
     void trunc_pr(const vector<int>& regs, int size, U& proc);
 
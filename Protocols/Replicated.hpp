@@ -20,6 +20,7 @@
 
 #include "ReplicatedPO.hpp"
 #include "Math/Z2k.hpp"
+#include "Math/Gemm.h"
 
 template<class T>
 ProtocolBase<T>::ProtocolBase() :
@@ -288,7 +289,7 @@ void Replicated<T>::start_exchange()
 {
     prepare_exchange();
     os[0].append(0);
-    P.send_relative(1, os[0]);
+    P.request_send(P.get_player(1), os[0]);
     this->rounds++;
 }
 
@@ -296,6 +297,7 @@ template<class T>
 void Replicated<T>::stop_exchange()
 {
     P.receive_relative(-1, os[1]);
+    P.wait_send(P.get_player(1), os[0]);
     check_received();
 }
 
@@ -368,6 +370,42 @@ inline T Replicated<T>::finalize_dotprod(int length)
     return finalize_mul();
 }
 
+template<class T>
+template<int>
+void Replicated<T>::prepare_matmul(SubProcessor<T>&, const T* A, const T* B,
+        const array<int, 3>& dims)
+{
+    typedef typename T::clear clear;
+    size_t n = dims[0], m = dims[1], l = dims[2];
+
+    // x * y = x[0] * (y[0] + y[1]) + x[1] * y[0] as one product
+    // of [A[0] | A[1]] and [B[0] + B[1]; B[0]]
+    vector<clear> left(n * 2 * m), right(2 * m * l), products(n * l);
+    for (size_t i = 0; i < n; i++)
+        for (size_t k = 0; k < m; k++)
+        {
+            auto& x = A[i * m + k];
+            left[i * 2 * m + k] = x[0];
+            left[i * 2 * m + m + k] = x[1];
+        }
+    for (size_t k = 0; k < m; k++)
+        for (size_t j = 0; j < l; j++)
+        {
+            auto& y = B[k * l + j];
+            right[k * l + j] = y.lazy_sum();
+            right[(m + k) * l + j] = y[0];
+        }
+
+    gemm_add(products.data(), left.data(), right.data(), n, 2 * m, l,
+            OnlineOptions::singleton.matrix_threads);
+
+    for (auto& x : products)
+    {
+        x.normalize();
+        prepare_reshare(x);
+    }
+}
+
 template<class T>
 T Replicated<T>::get_random()
 {
@@ -22,7 +22,7 @@ void ReplicatedMC<T>::POpen_Begin(vector<typename T::open_type>&,
         const vector<T>& S, const Player& P)
 {
     prepare(S);
-    P.send_relative(-1, to_send);
+    P.request_send(P.get_player(-1), to_send);
 }
 
 template<class T>
@@ -50,6 +50,7 @@ void ReplicatedMC<T>::POpen_End(vector<typename T::open_type>& values,
         const vector<T>& S, const Player& P)
 {
     P.receive_relative(1, o);
+    P.wait_send(P.get_player(-1), to_send);
     finalize(values, S);
 }
 
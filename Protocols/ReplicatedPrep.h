@@ -19,6 +19,8 @@
 
 #include <array>
 
+template<class T> class PrepProducer;
+
 template<class T>
 void bits_from_random(vector<T>& bits, typename T::Protocol& protocol);
 
@@ -60,6 +62,9 @@ protected:
     SubProcessor<T>* proc;
     Player* P;
 
+    // background generation by type if enabled
+    array<PrepProducer<T>*, N_DTYPE> producers;
+
     virtual void buffer_triples() { throw runtime_error("no triples"); }
     virtual void buffer_squares() { throw runtime_error("no squares"); }
     virtual void buffer_inverses();
@@ -86,6 +91,10 @@ protected:
             const vector<T>& sums,
             const vector<vector<typename T::bit_type::part_type>>& bits);
 
+    template<class U, class V>
+    void buffer_central(const vector<BufferPrep<T>*>& dests,
+            const vector<long long>& required, U get_buffer, V buffer);
+
 public:
     typedef T share_type;
 
@@ -141,7 +150,14 @@ public:
     SubProcessor<T>* get_proc() { return proc; }
     void set_proc(SubProcessor<T>* proc) { this->proc = proc; }
 
+    void set_producer(Dtype type, PrepProducer<T>* producer);
+
     void buffer_extra(Dtype type, int n_items);
+
+    /// Generate what other instances need according to the compiler
+    /// in one batch per type and move it there
+    void buffer_central(const vector<BufferPrep<T>*>& dests,
+            const vector<DataPositions>& usages, ThreadQueues* queues = 0);
 };
 
 /**
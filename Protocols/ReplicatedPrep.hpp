@@ -20,6 +20,7 @@
 #include "ShuffleSacrifice.hpp"
 #include "GC/ShareThread.hpp"
 #include "GC/BitAdder.hpp"
+#include "PrepProducer.hpp"
 
 class InScope
 {
@@ -64,11 +65,15 @@ BufferPrep<T>::BufferPrep(DataPositions& usage) :
         Preprocessing<T>(usage), n_bit_rounds(0),
 		proc(0), P(0)
 {
+    producers.fill(0);
 }
 
 template<class T>
 BufferPrep<T>::~BufferPrep()
 {
+    for (auto producer : producers)
+        delete producer;
+
     string type_string = T::type_string();
 
 #ifdef VERBOSE
@@ -166,6 +171,13 @@ BitPrep<T>::~BitPrep()
     }
 }
 
+template<class T>
+void BufferPrep<T>::set_producer(Dtype type, PrepProducer<T>* producer)
+{
+    delete producers.at(type);
+    producers.at(type) = producer;
+}
+
 template<class T>
 void BufferPrep<T>::clear()
 {
@@ -232,7 +244,10 @@ void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
         if (OnlineOptions::singleton.has_option("verbose_triples"))
             fprintf(stderr, "out of %s triples\n", T::type_string().c_str());
         InScope in_scope(this->do_count, false, *this);
-        buffer_triples();
+        if (producers[DATA_TRIPLE])
+            producers[DATA_TRIPLE]->pull(triples);
+        else
+            buffer_triples();
         assert(not triples.empty());
     }
 
@@ -336,7 +351,10 @@ void BufferPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
         if (squares.empty())
         {
             InScope in_scope(this->do_count, false, *this);
-            buffer_squares();
+            if (producers[DATA_SQUARE])
+                producers[DATA_SQUARE]->pull(squares);
+            else
+                buffer_squares();
         }
 
         a = squares.back()[0];
@@ -1209,8 +1227,13 @@ void BufferPrep<T>::get_one_no_count(Dtype dtype, T& a)
     while (bits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        buffer_bits();
-        n_bit_rounds++;
+        if (producers[DATA_BIT])
+            producers[DATA_BIT]->pull(bits);
+        else
+        {
+            buffer_bits();
+            n_bit_rounds++;
+        }
     }
 
     a = bits.back();
@@ -1388,15 +1411,10 @@ void BufferPrep<T>::buffer_inputs_as_usual(int player, SubProcessor<T>* proc)
     if (input.is_me(player))
     {
         SeededPRNG G;
-        vector<typename T::clear> rs;
-        rs.reserve(buffer_size);
-        for (int i = 0; i < buffer_size; i++)
-        {
-            typename T::clear r;
-            r.randomize(G);
+        vector<typename T::clear> rs(buffer_size);
+        G.randomize(rs);
+        for (auto& r : rs)
             input.add_mine(r);
-            rs.push_back(r);
-        }
         input.exchange();
         for (auto& r : rs)
             this->inputs[player].push_back({input.finalize(player), r});
@@ -1465,4 +1483,114 @@ void BufferPrep<T>::buffer_extra(Dtype type, int n_items)
     }
 }
 
+template<class T>
+template<class U, class V>
+void BufferPrep<T>::buffer_central(const vector<BufferPrep<T>*>& dests,
+        const vector<long long>& required, U get_buffer, V buffer)
+{
+    vector<size_t> missing;
+    size_t total = 0;
+    for (size_t i = 0; i < dests.size(); i++)
+    {
+        size_t have = get_buffer(*dests[i]).size();
+        missing.push_back(max(required[i], 0ll) > (long long) have ?
+                required[i] - have : 0);
+        total += missing.back();
+    }
+
+    auto& source = get_buffer(*this);
+    while (source.size() < total)
+    {
+        BufferScope<BufferPrep<T>> scope(*this,
+                min(total - source.size(), size_t(INT_MAX)));
+        buffer();
+    }
+
+    for (size_t i = 0; i < dests.size(); i++)
+    {
+        auto& dest = get_buffer(*dests[i]);
+        dest.insert(dest.end(), source.end() - missing[i], source.end());
+        source.erase(source.end() - missing[i], source.end());
+    }
+}
+
+template<class T>
+void BufferPrep<T>::buffer_central(const vector<BufferPrep<T>*>& dests,
+        const vector<DataPositions>& usages, ThreadQueues* queues)
+{
+    assert(dests.size() == usages.size());
+    if (dests.empty())
+        return;
+
+    auto field_type = T::clear::field_type();
+
+    vector<array<long long, N_DTYPE>> required;
+    for (auto& usage : usages)
+    {
+        // same accounting as in BaseMachine::batch_size()
+        auto x = usage.files.at(field_type);
+        if (T::LivePrep::bits_from_dabits())
+        {
+            x[DATA_DABIT] += x[DATA_BIT];
+            x[DATA_BIT] = 0;
+        }
+        else if (T::LivePrep::dabits_from_bits())
+        {
+            x[DATA_BIT] += x[DATA_DABIT];
+            x[DATA_DABIT] = 0;
+        }
+        required.push_back(x);
+    }
+
+    auto get_required = [&](Dtype type)
+    {
+        vector<long long> res;
+        for (size_t i = 0; i < dests.size(); i++)
+            // leave types with background generation alone
+            res.push_back(dests[i]->producers[type] ? 0 : required[i][type]);
+        return res;
+    };
+
+    InScope in_scope(this->do_count, false, *this);
+
+    buffer_central(dests, get_required(DATA_TRIPLE),
+            [](BufferPrep<T>& prep) -> vector<array<T, 3>>&
+            { return prep.triples; }, [this]() { buffer_triples(); });
+    buffer_central(dests, get_required(DATA_SQUARE),
+            [](BufferPrep<T>& prep) -> vector<array<T, 2>>&
+            { return prep.squares; }, [this]() { buffer_squares(); });
+    buffer_central(dests, get_required(DATA_INVERSE),
+            [](BufferPrep<T>& prep) -> vector<array<T, 2>>&
+            { return prep.inverses; }, [this]() { buffer_inverses(); });
+    buffer_central(dests, get_required(DATA_BIT),
+            [](BufferPrep<T>& prep) -> vector<T>&
+            { return prep.bits; }, [this]()
+            {
+                buffer_bits();
+                n_bit_rounds++;
+            });
+    buffer_central(dests, get_required(DATA_DABIT),
+            [](BufferPrep<T>& prep) -> vector<dabit<T>>&
+            { return prep.dabits; }, [this, queues]()
+            { buffer_dabits(queues); });
+
+    // only the generic input protocol uses input tuples
+    if (not is_same<typename T::Input, ::Input<T>>())
+        return;
+
+    for (size_t player = 0; player < usages.at(0).inputs.size(); player++)
+    {
+        vector<long long> required;
+        for (auto& usage : usages)
+            required.push_back(usage.inputs.at(player).at(field_type));
+        buffer_central(dests, required,
+                [player](BufferPrep<T>& prep) -> vector<InputTuple<T>>&
+                {
+                    if (prep.inputs.size() <= player)
+                        prep.inputs.resize(player + 1);
+                    return prep.inputs[player];
+                }, [this, player]() { buffer_inputs(player); });
+    }
+}
+
 #endif
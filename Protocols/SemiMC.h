@@ -38,6 +38,8 @@ public:
 template<class T>
 class DirectSemiMC : public SemiMC<T>
 {
+    octetStream to_send;
+
 public:
     DirectSemiMC() {}
     // emulate Direct_MAC_Check
@@ -74,10 +74,10 @@ void DirectSemiMC<T>::POpen_Begin(vector<typename T::open_type>& values,
 {
     values.clear();
     values.insert(values.begin(), S.begin(), S.end());
-    octetStream os;
+    to_send.reset_write_head();
     for (auto& x : values)
-        x.pack(os);
-    P.send_all(os);
+        x.pack(to_send);
+    P.request_send_all(to_send);
 }
 
 template<class T>
@@ -86,6 +86,7 @@ void DirectSemiMC<T>::POpen_End(vector<typename T::open_type>& values,
 {
     Bundle<octetStream> oss(P);
     P.receive_all(oss);
+    P.wait_send_all(to_send);
     direct_add_openings<typename T::open_type>(values, P, oss);
 }
 
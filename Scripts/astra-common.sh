@@ -11,6 +11,9 @@ for dir in Player-Data/3-$PROTOCOL-{{R,B}-64,2-{40,128}}; do
     for t in $(seq 0 100); do
 	mkfifo $dir/{Protocol,Outputs}-{edaBits-,}P{0,1,2}-T$t
     done
+    # shared-memory rings for these pipes left over
+    # from aborted runs with "-o astra_shm"
+    rm -f /dev/shm/mp-spdz-${dir//\//_}_* 2> /dev/null
 done
 
 export PLAYERS=3
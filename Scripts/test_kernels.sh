@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# optimized kernels against their generic counterparts
+
+make -j4 gfp-bench.x ntt-bench.x transpose-bench.x garbling-bench.x \
+     Programs/Circuits || exit 1
+
+./gfp-bench.x 10 3 || exit 1
+./ntt-bench.x 10 50 3 || exit 1
+./ntt-bench.x 12 62 3 || exit 1
+./transpose-bench.x 100 3 || exit 1
+./garbling-bench.x -r 1 || exit 1
@@ -0,0 +1,38 @@
+/*
+ * Backoff.h
+ *
+ */
+
+#ifndef TOOLS_BACKOFF_H_
+#define TOOLS_BACKOFF_H_
+
+#include <sched.h>
+#include <unistd.h>
+
+/**
+ * Waiting strategy for polling:
+ * spin briefly before yielding and eventually sleeping
+ */
+class Backoff
+{
+    int n_rounds;
+
+public:
+    Backoff() :
+            n_rounds(0)
+    {
+    }
+
+    void wait()
+    {
+        if (n_rounds < 100)
+            ;
+        else if (n_rounds < 1000)
+            sched_yield();
+        else
+            usleep(50);
+        n_rounds++;
+    }
+};
+
+#endif /* TOOLS_BACKOFF_H_ */
@@ -7,6 +7,7 @@
 #include "Processor/OnlineOptions.h"
 
 #include <fstream>
+#include <sys/mman.h>
 
 void sigbus_handler(int)
 {
@@ -16,6 +17,22 @@ void sigbus_handler(int)
     exit(1);
 }
 
+DiskVectorBase::DiskVectorBase() :
+        hits(0), misses(0), bytes_in(0), bytes_out(0)
+{
+    max_blocks = max(size_t(1),
+            OnlineOptions::singleton.disk_memory_cache * (1 << 20) / BLOCK_SIZE);
+}
+
+DiskVectorBase::~DiskVectorBase()
+{
+    if (OnlineOptions::singleton.verbose and (hits or misses))
+        cerr << "Disk memory cache: " << hits << " hits, " << misses
+                << " misses, " << bytes_in * 1e-6 << " MB paged in, "
+                << bytes_out * 1e-6 << " MB paged out" << endl;
+    boost::filesystem::remove(path);
+}
+
 void DiskVectorBase::init(size_t byte_size)
 {
     if (file.is_open())
@@ -44,5 +61,71 @@ void DiskVectorBase::init(size_t byte_size)
 
     boost::filesystem::remove(path);
 
+    // access pattern is announced explicitly
+    madvise(file.data(), byte_size, MADV_RANDOM);
+
     signal(SIGBUS, sigbus_handler);
 }
+
+void DiskVectorBase::access_bytes(size_t begin, size_t end)
+{
+    if (end <= begin)
+        return;
+
+    ScopeLock _(lock);
+    size_t first = begin / BLOCK_SIZE, last = (end - 1) / BLOCK_SIZE;
+    size_t missing_start = 0, n_missing = 0;
+    for (size_t block = first; block <= last; block++)
+    {
+        auto it = resident.find(block);
+        if (it != resident.end())
+        {
+            hits++;
+            lru.splice(lru.begin(), lru, it->second);
+            continue;
+        }
+
+        misses++;
+        lru.push_front(block);
+        resident[block] = lru.begin();
+        while (resident.size() > max_blocks)
+            evict();
+
+        // prefetch runs of missing blocks at once
+        if (n_missing and missing_start + n_missing == block)
+            n_missing++;
+        else
+        {
+            prefetch(missing_start, n_missing);
+            missing_start = block;
+            n_missing = 1;
+        }
+    }
+    prefetch(missing_start, n_missing);
+}
+
+void DiskVectorBase::prefetch(size_t first_block, size_t n_blocks)
+{
+    if (n_blocks == 0)
+        return;
+    size_t begin = first_block * BLOCK_SIZE;
+    size_t length = min(n_blocks * BLOCK_SIZE, file.size() - begin);
+    madvise(file.data() + begin, length, MADV_WILLNEED);
+    bytes_in += length;
+}
+
+void DiskVectorBase::evict()
+{
+    size_t block = lru.back();
+    lru.pop_back();
+    resident.erase(block);
+    size_t begin = block * BLOCK_SIZE;
+    size_t length = min(BLOCK_SIZE, file.size() - begin);
+    // the mapping is shared, so modified pages are written back
+#ifdef MADV_PAGEOUT
+    madvise(file.data() + begin, length, MADV_PAGEOUT);
+#else
+    madvise(file.data() + begin, length, MADV_DONTNEED);
+#endif
+    bytes_out += length;
+}
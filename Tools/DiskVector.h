@@ -9,19 +9,46 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/filesystem.hpp>
 
+#include <list>
+#include <unordered_map>
+
+#include "Tools/Lock.h"
+
+/*
+ * Memory-mapped file with a page cache of limited size on top.
+ * Accesses announced via access() are tracked in blocks, missing blocks
+ * are prefetched, and the least recently used blocks are released
+ * when the cache is full. This keeps the resident size bounded
+ * instead of leaving it to the kernel.
+ * The bound is advisory: accesses not announced via access(), for example
+ * outside of memory instructions like LDMS/STMS or indirect ones,
+ * are not tracked and only managed by the kernel.
+ */
 class DiskVectorBase
 {
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+    std::list<size_t> lru;
+    std::unordered_map<size_t, std::list<size_t>::iterator> resident;
+    size_t max_blocks;
+    Lock lock;
+
+    void prefetch(size_t first_block, size_t n_blocks);
+    void evict();
+
 protected:
     boost::iostreams::mapped_file file;
     boost::filesystem::path path;
 
 public:
-    ~DiskVectorBase()
-    {
-        boost::filesystem::remove(path);
-    }
+    size_t hits, misses, bytes_in, bytes_out;
+
+    DiskVectorBase();
+    ~DiskVectorBase();
 
     void init(size_t byte_size);
+
+    void access_bytes(size_t begin, size_t end);
 };
 
 template<class T>
@@ -48,6 +75,12 @@ public:
         data_ = (T*) file.data();
     }
 
+    void access(size_t index, size_t n)
+    {
+        access_bytes(index * sizeof(T),
+                std::min(index + n, size_) * sizeof(T));
+    }
+
     T* data()
     {
         return data_;
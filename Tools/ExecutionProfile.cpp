@@ -0,0 +1,179 @@
+/*
+ * ExecutionProfile.cpp
+ *
+ */
+
+#include "ExecutionProfile.h"
+#include "Processor/Instruction.h"
+#include "Processor/OnlineOptions.h"
+#include "Networking/Player.h"
+
+#include <fstream>
+
+ExecutionProfile::Entry& ExecutionProfile::Entry::operator+=(
+        const Entry& other)
+{
+    if (opcode < 0)
+        opcode = other.opcode;
+    calls += other.calls;
+    time += other.time;
+    rounds += other.rounds;
+    sent += other.sent;
+    received += other.received;
+    return *this;
+}
+
+thread_local ExecutionProfile::Scope* ExecutionProfile::Scope::current = 0;
+
+ExecutionProfile::Scope::Scope(Entry* entry, int opcode,
+        const NamedCommStats& stats) :
+        entry(entry), stats(stats), parent(0), start(), rounds(0), sent(0),
+        received(0)
+{
+    if (entry)
+    {
+        entry->opcode = opcode;
+        parent = current;
+        current = this;
+        rounds = stats.total_rounds();
+        sent = stats.sent;
+        received = stats.received;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+    }
+}
+
+ExecutionProfile::Scope::~Scope()
+{
+    if (entry)
+    {
+        timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        Entry total;
+        total.time = end.tv_sec - start.tv_sec
+                + 1e-9 * (end.tv_nsec - start.tv_nsec);
+        total.rounds = stats.total_rounds() - rounds;
+        total.sent = stats.sent - sent;
+        total.received = stats.received - received;
+
+        entry->calls++;
+        entry->time += total.time - nested.time;
+        entry->rounds += total.rounds - nested.rounds;
+        entry->sent += total.sent - nested.sent;
+        entry->received += total.received - nested.received;
+
+        if (parent)
+        {
+            // communication only counts if measured on the same player
+            if (&parent->stats != &stats)
+                total.rounds = total.sent = total.received = 0;
+            parent->nested += total;
+        }
+        current = parent;
+    }
+}
+
+bool ExecutionProfile::active()
+{
+    return not OnlineOptions::singleton.profile_file.empty();
+}
+
+ExecutionProfile::Tape& ExecutionProfile::get_tape(const string& name,
+        size_t size)
+{
+    auto& tape = tapes[name];
+    if (tape.size() < size)
+        tape.resize(size);
+    return tape;
+}
+
+ExecutionProfile& ExecutionProfile::operator+=(const ExecutionProfile& other)
+{
+    for (auto& x : other.tapes)
+    {
+        auto& tape = get_tape(x.first, x.second.size());
+        for (size_t i = 0; i < x.second.size(); i++)
+            tape[i] += x.second[i];
+    }
+    return *this;
+}
+
+map<int, ExecutionProfile::Entry> ExecutionProfile::by_opcode() const
+{
+    map<int, Entry> res;
+    for (auto& tape : tapes)
+        for (auto& entry : tape.second)
+            if (entry.calls)
+                res[entry.opcode] += entry;
+    return res;
+}
+
+void ExecutionProfile::output(const string& filename) const
+{
+    ofstream out(filename);
+    if (not out.good())
+        throw file_error(filename);
+
+    if (filename.size() >= 4 and filename.substr(filename.size() - 4) == ".csv")
+        write_csv(out);
+    else
+        write_json(out);
+
+    cerr << "Wrote instruction profile to " << filename << endl;
+}
+
+void ExecutionProfile::write_csv(ostream& os) const
+{
+    os << "tape,position,instruction,calls,seconds,rounds,bytes_sent,"
+            "bytes_received" << endl;
+    auto write = [&](const string& tape, const string& position,
+            const Entry& entry)
+    {
+        os << tape << "," << position << ","
+                << BaseInstruction::get_name(entry.opcode) << ","
+                << entry.calls << "," << entry.time << "," << entry.rounds
+                << "," << entry.sent << "," << entry.received << endl;
+    };
+
+    // totals by instruction first without location
+    for (auto& x : by_opcode())
+        write("", "", x.second);
+
+    for (auto& tape : tapes)
+        for (size_t i = 0; i < tape.second.size(); i++)
+            if (tape.second[i].calls)
+                write(tape.first, to_string(i), tape.second[i]);
+}
+
+void ExecutionProfile::write_json(ostream& os) const
+{
+    auto write = [&](const Entry& entry)
+    {
+        os << "\"instruction\": \"" << BaseInstruction::get_name(entry.opcode)
+                << "\", \"calls\": " << entry.calls << ", \"seconds\": "
+                << entry.time << ", \"rounds\": " << entry.rounds
+                << ", \"bytes_sent\": " << entry.sent
+                << ", \"bytes_received\": " << entry.received << "}";
+    };
+
+    os << "{" << endl << "  \"instructions\": [";
+    string sep = "\n";
+    for (auto& x : by_opcode())
+    {
+        os << sep << "    {";
+        write(x.second);
+        sep = ",\n";
+    }
+    os << endl << "  ]," << endl << "  \"locations\": [";
+
+    sep = "\n";
+    for (auto& tape : tapes)
+        for (size_t i = 0; i < tape.second.size(); i++)
+            if (tape.second[i].calls)
+            {
+                os << sep << "    {\"tape\": \"" << tape.first
+                        << "\", \"position\": " << i << ", ";
+                write(tape.second[i]);
+                sep = ",\n";
+            }
+    os << endl << "  ]" << endl << "}" << endl;
+}
@@ -0,0 +1,92 @@
+/*
+ * ExecutionProfile.h
+ *
+ */
+
+#ifndef TOOLS_EXECUTIONPROFILE_H_
+#define TOOLS_EXECUTIONPROFILE_H_
+
+#include <map>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <time.h>
+using namespace std;
+
+class NamedCommStats;
+
+/**
+ * Time and communication by instruction, collected per thread
+ * and merged at the end. Instructions are identified by tape name
+ * and position in the tape, which corresponds to the order of
+ * instructions in the assembler output of the compiler.
+ * Figures are exclusive, that is, an instruction calling another
+ * tape in the same thread is only charged for its own share.
+ */
+class ExecutionProfile
+{
+public:
+    struct Entry
+    {
+        int opcode;
+        size_t calls;
+        double time;
+        size_t rounds, sent, received;
+
+        Entry() :
+                opcode(-1), calls(0), time(0), rounds(0), sent(0), received(0)
+        {
+        }
+
+        Entry& operator+=(const Entry& other);
+    };
+
+    typedef vector<Entry> Tape;
+
+    /**
+     * Measure one instruction by comparing time and
+     * communication statistics before and after,
+     * minus what nested scopes have measured
+     */
+    class Scope
+    {
+        // innermost active scope in this thread
+        static thread_local Scope* current;
+
+        Entry* entry;
+        const NamedCommStats& stats;
+        Scope* parent;
+        timespec start;
+        size_t rounds, sent, received;
+        Entry nested;
+
+    public:
+        Scope(Entry* entry, int opcode, const NamedCommStats& stats);
+        ~Scope();
+    };
+
+private:
+    map<string, Tape> tapes;
+
+    void write_json(ostream& os) const;
+    void write_csv(ostream& os) const;
+
+public:
+    static bool active();
+
+    bool empty() const
+    {
+        return tapes.empty();
+    }
+
+    Tape& get_tape(const string& name, size_t size);
+
+    ExecutionProfile& operator+=(const ExecutionProfile& other);
+
+    map<int, Entry> by_opcode() const;
+
+    /// JSON or CSV depending on extension
+    void output(const string& filename) const;
+};
+
+#endif /* TOOLS_EXECUTIONPROFILE_H_ */
@@ -0,0 +1,157 @@
+/*
+ * SharedRing.cpp
+ *
+ */
+
+#include "SharedRing.h"
+#include "octetStream.h"
+#include "Exceptions.h"
+#include "Backoff.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+SharedRing::SharedRing() :
+        header(0), data(0), capacity(0), reader(false)
+{
+}
+
+SharedRing::~SharedRing()
+{
+    close();
+}
+
+string SharedRing::get_name(const string& path)
+{
+    string res = "/mp-spdz-" + path;
+    for (size_t i = 1; i < res.size(); i++)
+        if (res[i] == '/')
+            res[i] = '_';
+    return res;
+}
+
+void SharedRing::open(const string& path, bool reader, size_t capacity)
+{
+    close();
+    name = get_name(path);
+    this->reader = reader;
+    this->capacity = capacity;
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+        throw runtime_error("cannot open shared memory " + name + ": " +
+                strerror(errno));
+
+    // both sides use the same size, and the content starts zeroed
+    size_t size = sizeof(Header) + capacity;
+    if (ftruncate(fd, size))
+    {
+        ::close(fd);
+        throw runtime_error("cannot resize shared memory " + name);
+    }
+
+    void* memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+        throw runtime_error("cannot map shared memory " + name);
+
+    header = (Header*) memory;
+    data = (char*) memory + sizeof(Header);
+}
+
+void SharedRing::close()
+{
+    if (not header)
+        return;
+
+    if (reader)
+    {
+        header->reader_closed = 1;
+        // the writer may have finished before the reader started,
+        // so only the reader can remove the ring
+        shm_unlink(name.c_str());
+    }
+    else
+        header->writer_closed = 1;
+
+    munmap(header, sizeof(Header) + capacity);
+    header = 0;
+    data = 0;
+}
+
+void SharedRing::write(const void* buffer, size_t length)
+{
+    auto source = (const char*) buffer;
+    uint64_t head = header->head.load(memory_order_relaxed);
+
+    while (length > 0)
+    {
+        Backoff backoff;
+        uint64_t tail;
+        while ((tail = header->tail.load(memory_order_acquire)) + capacity
+                == head)
+        {
+            if (header->reader_closed)
+                throw runtime_error("reader of " + name + " has closed");
+            backoff.wait();
+        }
+
+        size_t offset = head % capacity;
+        size_t n = min(length, min(size_t(tail + capacity - head),
+                capacity - offset));
+        memcpy(data + offset, source, n);
+        source += n;
+        length -= n;
+        head += n;
+        header->head.store(head, memory_order_release);
+    }
+}
+
+void SharedRing::read(void* buffer, size_t length)
+{
+    auto dest = (char*) buffer;
+    uint64_t tail = header->tail.load(memory_order_relaxed);
+
+    while (length > 0)
+    {
+        Backoff backoff;
+        uint64_t head;
+        while ((head = header->head.load(memory_order_acquire)) == tail)
+        {
+            // check again because the writer might have finished meanwhile
+            if (header->writer_closed
+                    and header->head.load(memory_order_acquire) == tail)
+                throw runtime_error("writer of " + name + " has closed");
+            backoff.wait();
+        }
+
+        size_t offset = tail % capacity;
+        size_t n = min(length, min(size_t(head - tail), capacity - offset));
+        memcpy(dest, data + offset, n);
+        dest += n;
+        length -= n;
+        tail += n;
+        header->tail.store(tail, memory_order_release);
+    }
+}
+
+void SharedRing::send(const octetStream& os)
+{
+    assert(not reader);
+    uint64_t length = os.get_length();
+    write(&length, sizeof(length));
+    write(os.get_data(), length);
+}
+
+void SharedRing::receive(octetStream& os)
+{
+    assert(reader);
+    uint64_t length;
+    read(&length, sizeof(length));
+    os.reset_write_head();
+    read(os.append(length), length);
+}
@@ -0,0 +1,63 @@
+/*
+ * SharedRing.h
+ *
+ */
+
+#ifndef TOOLS_SHAREDRING_H_
+#define TOOLS_SHAREDRING_H_
+
+#include <atomic>
+#include <string>
+#include <stdint.h>
+using namespace std;
+
+class octetStream;
+
+/**
+ * Single-producer single-consumer ring buffer in POSIX shared memory
+ * for passing messages between processes on the same host.
+ * The writer blocks while the ring is full, the reader while it is empty.
+ */
+class SharedRing
+{
+    struct Header
+    {
+        atomic<uint64_t> head;
+        char padding0[64 - sizeof(atomic<uint64_t>)];
+        atomic<uint64_t> tail;
+        char padding1[64 - sizeof(atomic<uint64_t>)];
+        atomic<int> writer_closed, reader_closed;
+    };
+
+    string name;
+    Header* header;
+    char* data;
+    size_t capacity;
+    bool reader;
+
+    static string get_name(const string& path);
+
+    void write(const void* buffer, size_t length);
+    void read(void* buffer, size_t length);
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 26;
+
+    SharedRing();
+    ~SharedRing();
+
+    /// Open ring associated with ``path`` (file need not exist)
+    void open(const string& path, bool reader,
+            size_t capacity = DEFAULT_CAPACITY);
+    void close();
+
+    bool is_open() const
+    {
+        return header;
+    }
+
+    void send(const octetStream& os);
+    void receive(octetStream& os);
+};
+
+#endif /* TOOLS_SHAREDRING_H_ */
@@ -0,0 +1,74 @@
+/*
+ * SpscQueue.h
+ *
+ */
+
+#ifndef TOOLS_SPSCQUEUE_H_
+#define TOOLS_SPSCQUEUE_H_
+
+#include <atomic>
+#include <vector>
+#include <assert.h>
+using namespace std;
+
+/**
+ * Lock-free bounded queue between exactly one producer thread
+ * and one consumer thread. Items are moved in and out.
+ */
+template<class T>
+class SpscQueue
+{
+    vector<T> slots;
+    size_t mask;
+
+    // positions on separate cache lines to avoid false sharing
+    alignas(64) atomic<size_t> head;
+    alignas(64) atomic<size_t> tail;
+
+public:
+    // capacity is rounded up to a power of two
+    SpscQueue(size_t capacity) :
+            head(0), tail(0)
+    {
+        assert(capacity > 0);
+        size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+    size_t size() const
+    {
+        return tail.load(memory_order_acquire) - head.load(memory_order_acquire);
+    }
+
+    // producer only, returns false if full
+    bool push(T& item)
+    {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == slots.size())
+            return false;
+        slots[t & mask] = std::move(item);
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // consumer only, returns false if empty
+    bool pop(T& item)
+    {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire))
+            return false;
+        item = std::move(slots[h & mask]);
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+#endif /* TOOLS_SPSCQUEUE_H_ */
@@ -104,6 +104,53 @@ inline void ecb_aes_128_encrypt(__m128i* out, const __m128i* in, const octet* ke
         software_ecb_aes_128_encrypt<N>(out, in, (uint*) key);
 }
 
+#ifdef __VAES__
+// same as ecb_aes_128_encrypt() with four or two blocks per instruction
+template <int N>
+#ifndef __clang__
+__attribute__((optimize("unroll-loops")))
+#endif
+inline void vaes_ecb_aes_128_encrypt(__m128i* out, const __m128i* in, const octet* key)
+{
+    const __m128i* round_keys = (const __m128i*) key;
+#ifdef __AVX512F__
+    static_assert(N % 4 == 0, "number of blocks must be a multiple of four");
+    const int M = N / 4;
+    __m512i tmp[M];
+    __m512i k = _mm512_maskz_broadcast_i32x4(0xFFFF, round_keys[0]);
+    for (int i = 0; i < M; i++)
+        tmp[i] = _mm512_xor_si512(_mm512_loadu_si512(in + 4 * i), k);
+    for (int j = 1; j < 10; j++)
+    {
+        k = _mm512_maskz_broadcast_i32x4(0xFFFF, round_keys[j]);
+        for (int i = 0; i < M; i++)
+            tmp[i] = _mm512_aesenc_epi128(tmp[i], k);
+    }
+    k = _mm512_maskz_broadcast_i32x4(0xFFFF, round_keys[10]);
+    for (int i = 0; i < M; i++)
+        _mm512_storeu_si512(out + 4 * i, _mm512_aesenclast_epi128(tmp[i], k));
+#else
+    static_assert(N % 2 == 0, "number of blocks must be even");
+    const int M = N / 2;
+    __m256i tmp[M];
+    __m256i k = _mm256_broadcastsi128_si256(round_keys[0]);
+    for (int i = 0; i < M; i++)
+        tmp[i] = _mm256_xor_si256(
+                _mm256_loadu_si256((__m256i*) (in + 2 * i)), k);
+    for (int j = 1; j < 10; j++)
+    {
+        k = _mm256_broadcastsi128_si256(round_keys[j]);
+        for (int i = 0; i < M; i++)
+            tmp[i] = _mm256_aesenc_epi128(tmp[i], k);
+    }
+    k = _mm256_broadcastsi128_si256(round_keys[10]);
+    for (int i = 0; i < M; i++)
+        _mm256_storeu_si256((__m256i*) (out + 2 * i),
+                _mm256_aesenclast_epi128(tmp[i], k));
+#endif
+}
+#endif
+
 template <int N>
 inline void ecb_aes_128_encrypt(__m128i* out, const __m128i* in, const octet* key, const int* indices)
 {
@@ -48,6 +48,42 @@ inline bool cpu_has_avx2()
 #endif
 }
 
+inline bool cpu_has_avx512ifma()
+{
+#ifdef CHECK_AVX512IFMA
+    return check_cpu(7, false, 16) and check_cpu(7, false, 21);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_avx512vbmi()
+{
+#ifdef CHECK_AVX512VBMI
+    return check_cpu(7, true, 1) and check_cpu(7, false, 30);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_gfni()
+{
+#ifdef CHECK_GFNI
+    return check_cpu(7, true, 8);
+#else
+    return true;
+#endif
+}
+
+inline bool cpu_has_vaes()
+{
+#ifdef CHECK_VAES
+    return check_cpu(7, true, 9);
+#else
+    return true;
+#endif
+}
+
 inline bool cpu_has_avx(bool force = false)
 {
     (void) force;
@@ -13,6 +13,19 @@
 #include <iostream>
 using namespace std;
 
+#if defined(__VAES__) && defined(__AES__)
+namespace
+{
+
+bool vaes_usable()
+{
+  static bool res = cpu_has_vaes();
+  return res;
+}
+
+}
+#endif
+
 
 PRNG::PRNG() :
     cnt(0), n_cached_bits(0), cached_bits(0), initialized(false)
@@ -136,6 +149,21 @@ void PRNG::hash()
     memcpy(random, tmp, RAND_SIZE);
     memcpy(seed, tmp + RAND_SIZE, SEED_SIZE);
   #else
+#if defined(__VAES__) && defined(__AES__)
+    if (not useC and vaes_usable())
+      {
+#ifdef __AVX512F__
+        // whole buffer in registers
+        const int N = PIPELINES * N_CACHE;
+#else
+        const int N = 2 * PIPELINES;
+#endif
+        for (int i = 0; i < RAND_SIZE; i += N * AES_BLK_SIZE)
+          vaes_ecb_aes_128_encrypt<N>((__m128i*) (random + i),
+              (__m128i*) (state + i), KeySchedule);
+      }
+    else
+#endif
     for (int i = 0; i < N_CACHE; i++)
       if (useC)
         software_ecb_aes_128_encrypt<PIPELINES>(
@@ -234,6 +262,82 @@ void PRNG::randomBnd(mp_limb_t* res, const mp_limb_t* B, size_t n_bytes, mp_limb
   }
 }
 
+void PRNG::randomBndBulk(mp_limb_t* res, const mp_limb_t* B, size_t n_bytes,
+    size_t n_items, size_t stride, mp_limb_t mask)
+{
+  assert(n_bytes != 0);
+  size_t n_limbs = DIV_CEIL(n_bytes, sizeof(mp_limb_t));
+  assert(n_limbs <= stride);
+  mp_limb_t top = B[n_limbs - 1];
+
+  auto sample = [&](mp_limb_t* x)
+    {
+      do
+        {
+          get_octets((octet*) x, n_bytes);
+          x[n_limbs - 1] &= mask;
+        }
+      // the most significant limb mostly decides
+      while (x[n_limbs - 1] > top
+          or (x[n_limbs - 1] == top and mpn_cmp(x, B, n_limbs) >= 0));
+    };
+
+  size_t i = 0;
+
+#ifdef __AVX512F__
+  if (n_limbs <= 2 and n_limbs == stride
+      and n_bytes == n_limbs * sizeof(mp_limb_t))
+    {
+      // compare eight limbs at once and compress the accepted candidates
+      // into the output, only if all of them might be needed
+      size_t per_vector = 8 / n_limbs;
+      __m512i bound, limb_mask;
+      if (n_limbs == 1)
+        {
+          bound = _mm512_set1_epi64(B[0]);
+          limb_mask = _mm512_set1_epi64(mask);
+        }
+      else
+        {
+          // masked broadcast avoids a false uninitialized warning
+          bound = _mm512_maskz_broadcast_i32x4(0xFFFF,
+              _mm_set_epi64x(B[1], B[0]));
+          limb_mask = _mm512_maskz_broadcast_i32x4(0xFFFF,
+              _mm_set_epi64x(mask, -1));
+        }
+
+      while (n_items - i >= per_vector)
+        {
+          if (cnt > RAND_SIZE - 64)
+            {
+              sample(res + i * stride);
+              i++;
+              continue;
+            }
+
+          __m512i x = _mm512_and_si512(_mm512_loadu_si512(random + cnt),
+              limb_mask);
+          cnt += 64;
+          if (cnt == RAND_SIZE)
+            next();
+          __mmask8 accept = _mm512_cmplt_epu64_mask(x, bound);
+          if (n_limbs == 2)
+            {
+              // most significant limbs in odd lanes
+              __mmask8 equal = _mm512_cmpeq_epu64_mask(x, bound);
+              accept = (accept & 0xAA) | (equal & 0xAA & (accept << 1));
+              accept |= accept >> 1;
+            }
+          _mm512_mask_compressstoreu_epi64(res + i * stride, accept, x);
+          i += __builtin_popcount(accept) / n_limbs;
+        }
+    }
+#endif
+
+  for (; i < n_items; i++)
+    sample(res + i * stride);
+}
+
 template<>
 void PRNG::randomBnd(bigint& x, const bigint& B, bool positive)
 {
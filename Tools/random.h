@@ -9,6 +9,7 @@
 #include "Networking/data.h"
 
 #include <gmp.h>
+#include <vector>
 
 #define USE_AES
 
@@ -132,6 +133,18 @@ class PRNG
    template<int N_BYTES>
    void randomBnd(mp_limb_t* res, const mp_limb_t* B, mp_limb_t mask = -1);
    void randomBnd(mp_limb_t* res, const mp_limb_t* B, size_t n_bytes, mp_limb_t mask = -1);
+   /**
+    * Random integers in ``[0, B-1]`` for several items,
+    * consuming the same randomness as one call per item
+    * @param res result with ``stride`` limbs per item
+    * @param B bound
+    * @param n_bytes byte length of candidates
+    * @param n_items number of items
+    * @param stride limbs per item
+    * @param mask mask for the most significant limb of candidates
+    */
+   void randomBndBulk(mp_limb_t* res, const mp_limb_t* B, size_t n_bytes,
+       size_t n_items, size_t stride, mp_limb_t mask = -1);
 
    /// Random 64-bit integer
    word get_word()
@@ -175,6 +188,14 @@ class PRNG
    template<class T>
    T get()
      { T res; res.randomize(*this); return res; }
+
+   /// Random instances of any supported class
+   template<class T>
+   void randomize(T* res, size_t n)
+     { T::randomize_many(*this, res, n); }
+   template<class T>
+   void randomize(vector<T>& res)
+     { randomize(res.data(), res.size()); }
 };
 
 /// Randomly seeded pseudo-random number generator
@@ -0,0 +1,71 @@
+/*
+ * export-session.cpp
+ *
+ * Resident virtual machine with a controller per party,
+ * run "export-session.x <party> server <socket>"
+ * and "export-session.x <party> client <socket> [n_calls]"
+ *
+ */
+
+#include "Machines/minimal.hpp"
+#include "Processor/FunctionSession.hpp"
+#include "Tools/time-func.h"
+
+typedef Rep3Share2<64> share_type;
+
+void serve(int my_number, const string& socket_path)
+{
+    int port_base = 9999;
+    Names N(my_number, 3, "localhost", port_base);
+    Machine<share_type> machine(N);
+
+    FunctionSession<share_type> session(machine, socket_path);
+    session.run();
+}
+
+void control(int my_number, const string& socket_path, int n_calls)
+{
+    FunctionClient<share_type> client(socket_path);
+
+    int n = 1000;
+    vector<share_type> inputs;
+    for (int i = 0; i < n; i++)
+        inputs.push_back(share_type::constant(n - i, my_number));
+
+    for (int i = 0; i < n_calls; i++)
+    {
+        vector<FunctionArgument> args = {{inputs, true}};
+        FunctionArgument res;
+        Timer timer;
+        timer.start();
+        client.call("sort", res, args);
+        cout << "call " << i << " took " << timer.elapsed() * 1e3 << " ms"
+                << endl;
+    }
+
+    client.stop();
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 4)
+    {
+        cerr << "Usage: " << argv[0]
+                << " <party> server|client <socket> [n_calls]" << endl;
+        exit(1);
+    }
+
+    int my_number = atoi(argv[1]);
+    string mode = argv[2];
+    string socket_path = argv[3];
+
+    if (mode == "server")
+        serve(my_number, socket_path);
+    else if (mode == "client")
+        control(my_number, socket_path, argc > 4 ? atoi(argv[4]) : 10);
+    else
+    {
+        cerr << "Unknown mode: " << mode << endl;
+        exit(1);
+    }
+}
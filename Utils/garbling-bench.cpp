@@ -0,0 +1,307 @@
+/*
+ * garbling-bench.cpp
+ *
+ * Local comparison of half-gates and three-halves garbling
+ * on Bristol Fashion circuits (Programs/Circuits)
+ *
+ */
+
+#include "Yao/YaoGate.h"
+#include "Tools/MMO.hpp"
+#include "Tools/time-func.h"
+#include "Tools/random.h"
+
+#include <fstream>
+
+struct CircuitGate
+{
+    string type;
+    vector<int> inputs, outputs;
+};
+
+class BristolCircuit
+{
+public:
+    int n_wires;
+    vector<int> input_wires, output_wires;
+    vector<CircuitGate> gates;
+    size_t n_ands;
+
+    BristolCircuit(const string& filename);
+
+    // plaintext evaluation
+    vector<bool> evaluate(const vector<bool>& inputs) const;
+};
+
+BristolCircuit::BristolCircuit(const string& filename) :
+        n_ands(0)
+{
+    ifstream file(filename);
+    if (not file.good())
+        throw file_error(filename);
+
+    int n_gates, n, size;
+    file >> n_gates >> n_wires;
+    int n_inputs = 0, n_outputs = 0;
+    file >> n;
+    for (int i = 0; i < n; i++)
+    {
+        file >> size;
+        n_inputs += size;
+    }
+    file >> n;
+    for (int i = 0; i < n; i++)
+    {
+        file >> size;
+        n_outputs += size;
+    }
+    for (int i = 0; i < n_inputs; i++)
+        input_wires.push_back(i);
+    for (int i = 0; i < n_outputs; i++)
+        output_wires.push_back(n_wires - n_outputs + i);
+
+    gates.resize(n_gates);
+    for (auto& gate : gates)
+    {
+        int n_in, n_out;
+        file >> n_in >> n_out;
+        gate.inputs.resize(n_in);
+        gate.outputs.resize(n_out);
+        for (auto& x : gate.inputs)
+            file >> x;
+        for (auto& x : gate.outputs)
+            file >> x;
+        file >> gate.type;
+        if (gate.type == "AND")
+            n_ands++;
+        else if (gate.type == "MAND")
+            n_ands += n_out;
+    }
+
+    if (file.fail())
+        throw runtime_error("error parsing " + filename);
+}
+
+vector<bool> BristolCircuit::evaluate(const vector<bool>& inputs) const
+{
+    vector<bool> wires(n_wires);
+    for (size_t i = 0; i < input_wires.size(); i++)
+        wires.at(input_wires[i]) = inputs.at(i);
+
+    for (auto& x : gates)
+    {
+        auto& in = x.inputs;
+        auto& out = x.outputs;
+        if (x.type == "XOR")
+            wires[out[0]] = wires[in[0]] ^ wires[in[1]];
+        else if (x.type == "AND")
+            wires[out[0]] = wires[in[0]] and wires[in[1]];
+        else if (x.type == "MAND")
+            for (size_t i = 0; i < out.size(); i++)
+                wires[out[i]] = wires[in[i]] and wires[in[out.size() + i]];
+        else if (x.type == "INV")
+            wires[out[0]] = not wires[in[0]];
+        else if (x.type == "EQW")
+            wires[out[0]] = wires[in[0]];
+        else if (x.type == "EQ")
+            wires[out[0]] = in[0];
+        else
+            throw runtime_error("unknown gate: " + x.type);
+    }
+
+    vector<bool> res;
+    for (int i : output_wires)
+        res.push_back(wires[i]);
+    return res;
+}
+
+template<class T>
+class GarblingBench
+{
+    const BristolCircuit& circuit;
+    MMO mmo;
+
+    Key delta;
+    vector<YaoGarbleWire> garbler_wires;
+    vector<YaoEvalWire> evaluator_wires;
+    vector<T> table;
+    vector<bool> input_bits;
+
+    void garble_and(int left, int right, int out, long counter, T& gate)
+    {
+        Key labels[T::N_GARBLE_HASHES];
+        Key hashes[T::N_GARBLE_HASHES];
+        auto& l = garbler_wires[left];
+        auto& r = garbler_wires[right];
+        T::E_inputs(labels, l, r, delta.doubling(1), {}, counter);
+        mmo.hash<T::N_GARBLE_HASHES>(hashes, labels);
+        gate.and_garble(garbler_wires[out], hashes, l, r, delta);
+    }
+
+    void eval_and(int left, int right, int out, long counter, T& gate)
+    {
+        Key labels[T::N_EVAL_HASHES];
+        Key hashes[T::N_EVAL_HASHES];
+        auto& l = evaluator_wires[left];
+        auto& r = evaluator_wires[right];
+        T::eval_inputs(labels, l.key(), r.key(), counter);
+        mmo.hash<T::N_EVAL_HASHES>(hashes, labels);
+        gate.eval(evaluator_wires[out], hashes, l, r);
+    }
+
+public:
+    double garbling_time, evaluation_time;
+
+    GarblingBench(const BristolCircuit& circuit) :
+            circuit(circuit), garbling_time(0), evaluation_time(0)
+    {
+        garbler_wires.resize(circuit.n_wires);
+        evaluator_wires.resize(circuit.n_wires);
+        table.resize(circuit.n_ands);
+    }
+
+    size_t size()
+    {
+        return table.size() * sizeof(T);
+    }
+
+    void garble(PRNG& prng);
+    void evaluate(PRNG& prng);
+    void check();
+};
+
+template<class T>
+void GarblingBench<T>::garble(PRNG& prng)
+{
+    delta = prng.get_doubleword();
+    delta.set_signal(1);
+    for (int i : circuit.input_wires)
+        garbler_wires[i].randomize(prng);
+
+    Timer timer;
+    timer.start();
+    long counter = 0;
+    auto gate = table.begin();
+    for (auto& x : circuit.gates)
+    {
+        auto& in = x.inputs;
+        auto& out = x.outputs;
+        if (x.type == "XOR")
+            garbler_wires[out[0]].XOR(garbler_wires[in[0]],
+                    garbler_wires[in[1]]);
+        else if (x.type == "AND")
+            garble_and(in[0], in[1], out[0], counter++, *gate++);
+        else if (x.type == "MAND")
+            for (size_t i = 0; i < out.size(); i++)
+                garble_and(in[i], in[out.size() + i], out[i], counter++,
+                        *gate++);
+        else if (x.type == "INV")
+            garbler_wires[out[0]].set_full_key(
+                    garbler_wires[in[0]].full_key() ^ delta);
+        else if (x.type == "EQW")
+            garbler_wires[out[0]] = garbler_wires[in[0]];
+        else if (x.type == "EQ")
+            garbler_wires[out[0]].set_full_key(
+                    T::garble_public_input(in[0], delta));
+        else
+            throw runtime_error("unknown gate: " + x.type);
+    }
+    garbling_time = timer.elapsed();
+}
+
+template<class T>
+void GarblingBench<T>::evaluate(PRNG& prng)
+{
+    input_bits.clear();
+    for (int i : circuit.input_wires)
+    {
+        input_bits.push_back(prng.get_bit());
+        evaluator_wires[i].set(
+                garbler_wires[i].full_key() ^ (input_bits.back() ? delta : 0));
+    }
+
+    Timer timer;
+    timer.start();
+    long counter = 0;
+    auto gate = table.begin();
+    for (auto& x : circuit.gates)
+    {
+        auto& in = x.inputs;
+        auto& out = x.outputs;
+        if (x.type == "XOR")
+            evaluator_wires[out[0]].XOR(evaluator_wires[in[0]],
+                    evaluator_wires[in[1]]);
+        else if (x.type == "AND")
+            eval_and(in[0], in[1], out[0], counter++, *gate++);
+        else if (x.type == "MAND")
+            for (size_t i = 0; i < out.size(); i++)
+                eval_and(in[i], in[out.size() + i], out[i], counter++,
+                        *gate++);
+        else if (x.type == "INV" or x.type == "EQW")
+            evaluator_wires[out[0]] = evaluator_wires[in[0]];
+        else if (x.type == "EQ")
+            evaluator_wires[out[0]].set(0);
+    }
+    evaluation_time = timer.elapsed();
+}
+
+// decode the output labels and compare with plaintext evaluation
+template<class T>
+void GarblingBench<T>::check()
+{
+    auto expected = circuit.evaluate(input_bits);
+    for (size_t j = 0; j < circuit.output_wires.size(); j++)
+    {
+        int i = circuit.output_wires[j];
+        auto& key = evaluator_wires[i].key();
+        Key zero = garbler_wires[i].full_key();
+        if (key != zero and key != (zero ^ delta))
+            throw runtime_error("invalid output label");
+        if ((key != zero) != expected[j])
+            throw runtime_error("wrong output bit " + to_string(j));
+    }
+}
+
+template<class T>
+void run(const string& name, const BristolCircuit& circuit, int n_runs)
+{
+    GarblingBench<T> bench(circuit);
+    SeededPRNG prng;
+    double garbling_time = 0, evaluation_time = 0;
+    for (int i = 0; i < n_runs; i++)
+    {
+        bench.garble(prng);
+        bench.evaluate(prng);
+        bench.check();
+        garbling_time += bench.garbling_time;
+        evaluation_time += bench.evaluation_time;
+    }
+    cout << "  " << name << ": " << bench.size() << " bytes ("
+            << sizeof(T) << " per AND), garbling "
+            << garbling_time / n_runs * 1e3 << " ms, evaluation "
+            << evaluation_time / n_runs * 1e3 << " ms" << endl;
+}
+
+int main(int argc, const char** argv)
+{
+    vector<string> filenames;
+    int n_runs = 10;
+    for (int i = 1; i < argc; i++)
+        if (string(argv[i]) == "-r" and i + 1 < argc)
+            n_runs = atoi(argv[++i]);
+        else
+            filenames.push_back(argv[i]);
+
+    if (filenames.empty())
+        for (string name : {"aes_128", "sha256", "mult64", "adder64"})
+            filenames.push_back("Programs/Circuits/" + name + ".txt");
+
+    for (auto& filename : filenames)
+    {
+        BristolCircuit circuit(filename);
+        cout << filename << ": " << circuit.n_ands << " AND gates, "
+                << circuit.gates.size() << " gates in total" << endl;
+        run<YaoHalfGate>("half-gates", circuit, n_runs);
+        run<YaoThreeHalvesGate>("three halves", circuit, n_runs);
+    }
+}
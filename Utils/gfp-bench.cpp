@@ -0,0 +1,153 @@
+/*
+ * gfp-bench.cpp
+ *
+ * Local comparison of element-wise and batched prime field arithmetic
+ *
+ */
+
+#include "Math/gfp.hpp"
+#include "Math/Setup.h"
+#include "Tools/time-func.h"
+#include "Tools/random.h"
+
+class Benchmark
+{
+    map<string, Timer> timers;
+    int n_reps;
+    size_t n;
+
+public:
+    Benchmark(int n_reps, size_t n) :
+            n_reps(n_reps), n(n)
+    {
+    }
+
+    template<class T, class U>
+    void run(string name, T scalar, U batched)
+    {
+        for (int i = 0; i < n_reps; i++)
+        {
+            {
+                TimeScope _(timers[name + " scalar"]);
+                scalar();
+            }
+            {
+                TimeScope _(timers[name + " batched"]);
+                batched();
+            }
+        }
+        double a = timers[name + " scalar"].elapsed(),
+                b = timers[name + " batched"].elapsed();
+        cout << name << ": " << a * 1e9 / n / n_reps << " vs "
+                << b * 1e9 / n / n_reps << " ns per element, speedup " << a / b
+                << endl;
+    }
+};
+
+template<class T>
+void check(const vector<T>& a, const vector<T>& b, string name)
+{
+    if (a != b)
+    {
+        cerr << "mismatch in " << name << endl;
+        exit(1);
+    }
+}
+
+template<class T>
+void bench(const bigint& p, size_t n, int n_reps)
+{
+    T::init_field(p);
+    cout << "p=" << p << " (" << numBits(p) << " bits, " << T::t()
+            << " limbs)" << endl;
+
+    PRNG G;
+    G.ReSeed();
+    vector<T> x(n), y(n), scalar(n), batched(n);
+    for (auto& a : x)
+        a.randomize(G);
+    for (auto& a : y)
+        a.randomize(G);
+
+    Benchmark benchmark(n_reps, n);
+
+    benchmark.run("mul", [&]() {
+        for (size_t i = 0; i < n; i++)
+            scalar[i] = x[i] * y[i];
+    }, [&]() {
+        T::mul_many(batched.data(), x.data(), y.data(), n);
+    });
+    check(scalar, batched, "mul");
+
+    benchmark.run("mul-add", [&]() {
+        for (size_t i = 0; i < n; i++)
+            scalar[i] += x[i] * y[i];
+    }, [&]() {
+        T::mul_add_many(batched.data(), x.data(), y.data(), n);
+    });
+    check(scalar, batched, "mul-add");
+
+    benchmark.run("add", [&]() {
+        for (size_t i = 0; i < n; i++)
+            scalar[i] = scalar[i] + x[i];
+    }, [&]() {
+        T::add_many(batched.data(), batched.data(), x.data(), n);
+    });
+    check(scalar, batched, "add");
+
+    benchmark.run("sub", [&]() {
+        for (size_t i = 0; i < n; i++)
+            scalar[i] = scalar[i] - y[i];
+    }, [&]() {
+        T::sub_many(batched.data(), batched.data(), y.data(), n);
+    });
+    check(scalar, batched, "sub");
+
+    // same seed for both to compare bulk with element-wise sampling
+    PRNG G_scalar, G_batched;
+    benchmark.run("random", [&]() {
+        G_scalar.SetSeed(G.get_seed());
+        for (auto& a : scalar)
+            a.randomize(G_scalar);
+    }, [&]() {
+        G_batched.SetSeed(G.get_seed());
+        G_batched.randomize(batched);
+    });
+    check(scalar, batched, "random");
+
+    T a, b;
+    benchmark.run("dot product", [&]() {
+        a = {};
+        for (size_t i = 0; i < n; i++)
+            a += x[i] * y[i];
+    }, [&]() {
+        T::dot_product(b, x.data(), y.data(), n);
+    });
+    check<T>({a}, {b}, "dot product");
+
+    cout << endl;
+}
+
+int main(int argc, char** argv)
+{
+    int log_n = 16, n_reps = 100;
+    if (argc > 1)
+        log_n = atoi(argv[1]);
+    if (argc > 2)
+        n_reps = atoi(argv[2]);
+
+    if (argc > 3)
+    {
+        cerr << "Usage: " << argv[0] << " [log_n [n_reps]]" << endl;
+        exit(1);
+    }
+
+    size_t n = 1 << log_n;
+    // separate types because the modulus is fixed per type
+    bench<gfp_<0, 1>>(generate_prime(64, 1 << 16), n, n_reps);
+    bench<gfp_<1, 2>>(generate_prime(128, 1 << 16), n, n_reps);
+    bench<gfp_<2, 4>>(generate_prime(256, 1 << 16), n, n_reps);
+    // scalar field of BLS12-377
+    bench<gfp_<3, 4>>(bigint("8444461749428370424248824938781546531375899335"
+            "154063827935233455917409239041"), n, n_reps);
+}
@@ -0,0 +1,109 @@
+/*
+ * ntt-bench.cpp
+ *
+ * Local comparison of the word-sized NTT and the generic FFT
+ * for power-of-two cyclotomics
+ *
+ */
+
+#include "FHE/FFT_Data.h"
+#include "FHE/FFT.h"
+#include "Math/Setup.h"
+#include "Math/modp.hpp"
+#include "Tools/time-func.h"
+#include "Tools/random.h"
+
+int main(int argc, char** argv)
+{
+    int log_n = 12, lgp = 50, n_reps = 100;
+    if (argc > 1)
+        log_n = atoi(argv[1]);
+    if (argc > 2)
+        lgp = atoi(argv[2]);
+    if (argc > 3)
+        n_reps = atoi(argv[3]);
+
+    if (argc > 4 or lgp > 62)
+    {
+        cerr << "Usage: " << argv[0] << " [log_n [lgp [n_reps]]]" << endl;
+        cerr << "lgp must be at most 62" << endl;
+        exit(1);
+    }
+
+    int n = 1 << log_n;
+    bigint p;
+    generate_prime(p, lgp, 2 * n, true);
+    Zp_Data PrD(p);
+    FFT_Data FFTD(Ring(2 * n), PrD);
+
+    PRNG G;
+    G.ReSeed();
+    vector<modp> input(n);
+    for (auto& x : input)
+        x.randomize(G, PrD);
+
+    cerr << "n=" << n << ", p=" << p << " (" << numBits(p) << " bits)" << endl;
+
+    auto& ntt = FFTD.get_ntt(0);
+    auto& inverse_ntt = FFTD.get_ntt(1);
+    if (not ntt.active() or not inverse_ntt.active())
+    {
+        cerr << "word-sized NTT not applicable" << endl;
+        exit(1);
+    }
+
+    // inverse as in Ring_Element::change_rep()
+    modp root2;
+    Sqr(root2, FFTD.get_root(1), PrD);
+
+    vector<modp> generic, word;
+    Timer generic_timer, word_timer;
+    for (int i = 0; i < n_reps; i++)
+    {
+        generic = input;
+        generic_timer.start();
+        FFT_Iter2(generic, n, FFTD.get_roots(), PrD);
+        generic_timer.stop();
+
+        word = input;
+        word_timer.start();
+        ntt.apply(word);
+        word_timer.stop();
+
+        if (word != generic)
+        {
+            cerr << "mismatch between transforms" << endl;
+            exit(1);
+        }
+
+        FFT_Iter(generic, n, root2, PrD);
+        inverse_ntt.apply(word);
+
+        if (word != generic)
+        {
+            cerr << "mismatch between inverse transforms" << endl;
+            exit(1);
+        }
+
+        // undo scaling and twisting to recover the input
+        modp w = FFTD.get_iphi();
+        for (int j = 0; j < n; j++)
+        {
+            Mul(word[j], word[j], w, PrD);
+            Mul(w, w, FFTD.get_root(1), PrD);
+        }
+
+        if (word != input)
+        {
+            cerr << "round trip failed" << endl;
+            exit(1);
+        }
+    }
+
+    cout << "Generic FFT: " << generic_timer.elapsed() * 1e6 / n_reps
+            << " us per transform" << endl;
+    cout << "Word NTT: " << word_timer.elapsed() * 1e6 / n_reps
+            << " us per transform" << endl;
+    cout << "Speedup: " << generic_timer.elapsed() / word_timer.elapsed()
+            << endl;
+}
@@ -0,0 +1,64 @@
+/*
+ * transpose-bench.cpp
+ *
+ * Local comparison of the dispatched and the generic 128x128 bit
+ * transpose
+ *
+ */
+
+#include "OT/BitMatrix.h"
+#include "Tools/time-func.h"
+#include "Tools/random.h"
+
+int main(int argc, char** argv)
+{
+    int n_squares = 1000, n_reps = 100;
+    if (argc > 1)
+        n_squares = atoi(argv[1]);
+    if (argc > 2)
+        n_reps = atoi(argv[2]);
+
+    if (argc > 3)
+    {
+        cerr << "Usage: " << argv[0] << " [n_squares [n_reps]]" << endl;
+        exit(1);
+    }
+
+    PRNG G;
+    G.ReSeed();
+    vector<square128> input(n_squares);
+    for (auto& x : input)
+        x.randomize(G);
+
+    vector<square128> generic, dispatched;
+    Timer generic_timer, dispatched_timer;
+    for (int i = 0; i < n_reps; i++)
+    {
+        generic = input;
+        generic_timer.start();
+        for (auto& x : generic)
+            x.transpose_unpack();
+        generic_timer.stop();
+
+        dispatched = input;
+        dispatched_timer.start();
+        square128::transpose(dispatched.data(), dispatched.size());
+        dispatched_timer.stop();
+
+        for (int j = 0; j < n_squares; j++)
+            if (not (dispatched[j] == generic[j]))
+            {
+                cerr << "mismatch between transposes" << endl;
+                exit(1);
+            }
+    }
+
+    cout << "Generic transpose: "
+            << generic_timer.elapsed() * 1e9 / n_squares / n_reps
+            << " ns per square" << endl;
+    cout << "Dispatched transpose: "
+            << dispatched_timer.elapsed() * 1e9 / n_squares / n_reps
+            << " ns per square" << endl;
+    cout << "Speedup: "
+            << generic_timer.elapsed() / dispatched_timer.elapsed() << endl;
+}
@@ -15,8 +15,10 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts) :
-        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous)
+YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts,
+        YaoStore::Phase phase, string store_dir) :
+        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous),
+        phase(phase), store_dir(store_dir)
 {
 }
 
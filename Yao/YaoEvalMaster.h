@@ -9,13 +9,17 @@
 #include "GC/ThreadMaster.h"
 #include "GC/Secret.h"
 #include "YaoEvalWire.h"
+#include "YaoStore.h"
 
 class YaoEvalMaster : public GC::ThreadMaster<GC::Secret<YaoEvalWire>>
 {
 public:
     bool continuous;
+    YaoStore::Phase phase;
+    string store_dir;
 
-    YaoEvalMaster(bool continuous, OnlineOptions& opts);
+    YaoEvalMaster(bool continuous, OnlineOptions& opts,
+            YaoStore::Phase phase = YaoStore::NONE, string store_dir = "");
 
     GC::Thread<GC::Secret<YaoEvalWire>>* new_thread(int i);
 };
@@ -31,8 +31,30 @@ void YaoEvaluator::pre_run()
 {
 	if (master.opts.cmd_private_output_file.empty())
 		processor.out.activate(not continuous());
-	if (not continuous())
+	if (continuous())
+		return;
+
+	switch (master.phase)
+	{
+	case YaoStore::OFFLINE:
+		receive_to_disk(*P);
+		break;
+	case YaoStore::ONLINE:
+		store.open_read(get_store_filename());
+		break;
+	default:
 		receive_to_store(*P);
+	}
+}
+
+void YaoEvaluator::post_run()
+{
+	if (master.phase == YaoStore::ONLINE)
+	{
+		store.close_read();
+		// a garbled circuit must not be evaluated twice
+		remove(get_store_filename().c_str());
+	}
 }
 
 void YaoEvaluator::run(GC::Program& program)
@@ -41,7 +63,7 @@ void YaoEvaluator::run(GC::Program& program)
 
 	if (continuous())
 		run(program, *P);
-	else
+	else if (master.phase != YaoStore::OFFLINE)
 	{
 		run_from_store(program);
 	}
@@ -69,8 +91,16 @@ void YaoEvaluator::run_from_store(GC::Program& program)
 	machine.reset_timer();
 	do
 	{
-		gates_store.pop(gates);
-		output_masks_store.pop(output_masks);
+		if (store.is_open())
+		{
+			if (not (store.read(gates) and store.read(output_masks)))
+				throw runtime_error("not enough garbled circuit in store");
+		}
+		else
+		{
+			gates_store.pop(gates);
+			output_masks_store.pop(output_masks);
+		}
 	}
 	while(GC::DONE_BREAK != program.execute(processor, master.memory, -1));
 }
@@ -100,3 +130,19 @@ void YaoEvaluator::receive_to_store(Player& P)
 		output_masks_store.push(output_masks);
 	}
 }
+
+void YaoEvaluator::receive_to_disk(Player& P)
+{
+	store.open_write(get_store_filename());
+	while (receive(P))
+	{
+		store.write(gates);
+		store.write(output_masks);
+	}
+	store.close_write();
+}
+
+string YaoEvaluator::get_store_filename()
+{
+	return YaoStore::get_filename(master.store_dir, "Evaluator", thread_num);
+}
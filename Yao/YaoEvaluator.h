@@ -25,11 +25,15 @@ protected:
 	ReceivedMsg gates;
 	ReceivedMsgStore gates_store;
 
+	YaoStore store;
+
 	YaoEvalMaster& master;
 
 	friend class YaoCommon<YaoEvalWire>;
 	friend class YaoEvalWire;
 
+	string get_store_filename();
+
 public:
 	ReceivedMsg output_masks;
 	ReceivedMsgStore output_masks_store;
@@ -46,11 +50,13 @@ public:
 	bool continuous() { return master.continuous; }
 
 	void pre_run();
+	void post_run();
 	void run(GC::Program& program);
 	void run(GC::Program& program, Player& P);
 	void run_from_store(GC::Program& program);
 	bool receive(Player& P);
 	void receive_to_store(Player& P);
+	void receive_to_disk(Player& P);
 
 	void load_gate(YaoGate& gate);
 
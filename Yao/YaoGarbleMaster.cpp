@@ -15,13 +15,37 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold) :
-        super(opts), continuous(continuous), threshold(threshold)
+YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts,
+        int threshold, YaoStore::Phase phase, string store_dir) :
+        super(opts), continuous(continuous), threshold(threshold),
+        phase(phase), store_dir(store_dir)
 {
+    YaoStore store;
+    string filename = YaoStore::get_filename(store_dir, "Garbler-Delta");
+    if (phase == YaoStore::ONLINE)
+    {
+        // the circuit must be garbled with the same delta as the inputs
+        ReceivedMsg buffer;
+        store.open_read(filename);
+        if (not store.read(buffer))
+            throw runtime_error("no delta in " + filename);
+        buffer.unserialize(delta);
+        store.close_read();
+        remove(filename.c_str());
+        return;
+    }
+
     PRNG G;
     G.ReSeed();
     delta = G.get_doubleword();
     delta.set_signal(1);
+
+    if (phase == YaoStore::OFFLINE)
+    {
+        store.open_write(filename);
+        store.write(&delta, sizeof(delta));
+        store.close_write();
+    }
 }
 
 GC::Thread<GC::Secret<YaoGarbleWire>>* YaoGarbleMaster::new_thread(int i)
@@ -9,6 +9,7 @@
 #include "GC/ThreadMaster.h"
 #include "GC/Secret.h"
 #include "YaoGarbleWire.h"
+#include "YaoStore.h"
 #include "Processor/OnlineOptions.h"
 
 class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
@@ -20,8 +21,11 @@ class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
 public:
     bool continuous;
     int threshold;
+    YaoStore::Phase phase;
+    string store_dir;
 
-    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024);
+    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024,
+            YaoStore::Phase phase = YaoStore::NONE, string store_dir = "");
 
     GC::Thread<GC::Secret<YaoGarbleWire>>* new_thread(int i);
 
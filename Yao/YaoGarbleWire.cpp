@@ -105,8 +105,8 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 	int dl = GC::Secret<YaoGarbleWire>::default_length;
 	Key left_delta = delta.doubling(1);
 	Key right_delta = delta.doubling(2);
-	Key labels[4];
-	Key hashes[4];
+	Key labels[YaoGate::N_GARBLE_HASHES];
+	Key hashes[YaoGate::N_GARBLE_HASHES];
 	MMO& mmo = garbler.mmo;
 	for (auto it = args.begin() + start; it < args.begin() + end; it += 4)
 	{
@@ -116,7 +116,7 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 			YaoGate::E_inputs(labels, S[*(it + 2)].get_reg(0),
 					S[*(it + 3)].get_reg(0), left_delta, right_delta,
 					counter);
-			mmo.hash<4>(hashes, labels);
+			mmo.hash<YaoGate::N_GARBLE_HASHES>(hashes, labels);
 			auto& out = S[*(it + 1)];
 			out.resize_regs(1);
 			YaoGate::randomize(out.get_reg(0), prng);
@@ -140,7 +140,7 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 					counter++;
 					YaoGate::E_inputs(labels, left_wire,
 							right_wire, left_delta, right_delta, counter);
-					mmo.hash<4>(hashes, labels);
+					mmo.hash<YaoGate::N_GARBLE_HASHES>(hashes, labels);
 					//timers["Inner ref"].start();
 					//timers["Inner ref"].stop();
 					//timers["Randomizing"].start();
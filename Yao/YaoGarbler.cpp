@@ -61,6 +61,10 @@ void YaoGarbler::run(GC::Program& program)
 {
 	singleton = this;
 
+	// the circuit has been garbled and sent already
+	if (master.phase == YaoStore::ONLINE)
+		return;
+
 	GC::BreakType b = GC::TIME_BREAK;
 	while(GC::DONE_BREAK != b)
 	{
@@ -86,8 +90,20 @@ void YaoGarbler::post_run()
 {
 	if (not continuous())
 	{
-		P->send_long(1, YaoCommon::DONE);
-		process_receiver_inputs();
+		switch (master.phase)
+		{
+		case YaoStore::OFFLINE:
+			P->send_long(1, YaoCommon::DONE);
+			store_receiver_inputs();
+			break;
+		case YaoStore::ONLINE:
+			load_receiver_inputs();
+			process_receiver_inputs();
+			break;
+		default:
+			P->send_long(1, YaoCommon::DONE);
+			process_receiver_inputs();
+		}
 	}
 }
 
@@ -121,3 +137,31 @@ void YaoGarbler::process_receiver_inputs()
 		receiver_input_keys.pop_front();
 	}
 }
+
+void YaoGarbler::store_receiver_inputs()
+{
+	store.open_write(YaoStore::get_filename(master.store_dir, "Garbler",
+			thread_num));
+	for (auto& inputs : receiver_input_keys)
+		store.write(inputs.data(), inputs.size() * sizeof(Key));
+	store.close_write();
+	receiver_input_keys.clear();
+}
+
+void YaoGarbler::load_receiver_inputs()
+{
+	string filename = YaoStore::get_filename(master.store_dir, "Garbler",
+			thread_num);
+	store.open_read(filename);
+	ReceivedMsg buffer;
+	while (store.read(buffer))
+	{
+		receiver_input_keys.push_back({});
+		auto& inputs = receiver_input_keys.back();
+		inputs.resize(buffer.size() / sizeof(Key));
+		buffer.unserialize(inputs.data(), buffer.size());
+	}
+	store.close_read();
+	// reusing the keys would reveal the evaluator's inputs
+	remove(filename.c_str());
+}
@@ -33,6 +33,8 @@ protected:
 
 	SendBuffer gates;
 
+	YaoStore store;
+
 	Timer and_timer;
 	Timer and_proc_timer;
 	Timer and_main_thread_timer;
@@ -64,6 +66,8 @@ public:
 	void send(Player& P);
 
 	void process_receiver_inputs();
+	void store_receiver_inputs();
+	void load_receiver_inputs();
 
 	Key get_delta() { return master.get_delta(); }
 	void store_gate(const YaoGate& gate);
@@ -41,6 +41,24 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 	        "-b", // Flag token.
 	        "--batch-size" // Flag token.
 	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Only garble the circuit and store it with the key material "
+			"in a directory for a later run with --online (implies -O).", // Help description.
+			"--offline" // Flag token.
+	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Evaluate the circuit stored in a directory by a run with "
+			"--offline (implies -O).", // Help description.
+			"--online" // Flag token.
+	);
 	auto& online_opts = OnlineOptions::singleton;
 	online_opts = {opt, argc, argv, false};
 	NetworkOptionsWithNumber network_opts(opt, argc, argv, 2, false);
@@ -49,20 +67,37 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 	int my_num = online_opts.playerno;
 	int threshold;
 	bool continuous = not opt.get("-O")->isSet;
+	YaoStore::Phase phase = YaoStore::NONE;
+	string store_dir;
+	if (opt.isSet("--offline") and opt.isSet("--online"))
+		throw runtime_error("cannot run offline and online phase at once");
+	if (opt.isSet("--offline"))
+	{
+		phase = YaoStore::OFFLINE;
+		opt.get("--offline")->getString(store_dir);
+	}
+	if (opt.isSet("--online"))
+	{
+		phase = YaoStore::ONLINE;
+		opt.get("--online")->getString(store_dir);
+	}
+	if (phase != YaoStore::NONE)
+		continuous = false;
 	opt.get("-t")->getInt(threshold);
 	opt.get("-b")->getInt(online_opts.batch_size);
 	progname = online_opts.progname;
 
 	GC::ThreadMasterBase* master;
 	if (my_num == 0)
-	    master = new YaoGarbleMaster(continuous, online_opts, threshold);
+	    master = new YaoGarbleMaster(continuous, online_opts, threshold, phase,
+	            store_dir);
 	else
-	    master = new YaoEvalMaster(continuous, online_opts);
+	    master = new YaoEvalMaster(continuous, online_opts, phase, store_dir);
 
 	network_opts.start_networking(master->N, my_num);
 	master->run(progname);
 
-	if (my_num == 1)
+	if (my_num == 1 and phase != YaoStore::OFFLINE)
 	    ((YaoEvalMaster*)master)->machine.write_memory(0);
 
 	delete master;
@@ -0,0 +1,167 @@
+/*
+ * YaoStore.cpp
+ *
+ */
+
+#include "YaoStore.h"
+#include "YaoGate.h"
+#include "Tools/Hash.h"
+#include "Tools/Exceptions.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+namespace
+{
+
+struct Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t gate_size;
+
+	Header(int version) :
+			version(version), gate_size(sizeof(YaoGate))
+	{
+		memcpy(magic, "YaoStore", sizeof(magic));
+	}
+};
+
+}
+
+string YaoStore::get_filename(const string& dir, const string& role,
+		int thread_num)
+{
+	string res = dir + "/" + role;
+	if (thread_num >= 0)
+		res += "-T" + to_string(thread_num);
+	return res;
+}
+
+YaoStore::YaoStore() :
+		file(0), map(0), map_size(0), pos(0), released(0)
+{
+}
+
+YaoStore::~YaoStore()
+{
+	if (file)
+		fclose(file);
+	if (map)
+		munmap(map, map_size);
+}
+
+void YaoStore::check(bool condition)
+{
+	if (not condition)
+		throw runtime_error("corrupted garbled circuit store " + filename);
+}
+
+void YaoStore::open_write(const string& filename)
+{
+	this->filename = filename;
+	// the content allows to decrypt the garbled circuit
+	int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0 or not (file = fdopen(fd, "w")))
+		throw file_error(filename);
+	Header header(VERSION);
+	write(&header, sizeof(header));
+}
+
+void YaoStore::write(const void* data, size_t size)
+{
+	assert(file);
+	uint64_t length = size;
+	unsigned char checksum[Hash::hash_length];
+	Hash hash;
+	hash.update(data, size);
+	hash.final(checksum);
+	if (fwrite(&length, sizeof(length), 1, file) != 1
+			or fwrite(checksum, sizeof(checksum), 1, file) != 1
+			or (size and fwrite(data, size, 1, file) != 1))
+		throw file_error(filename);
+}
+
+void YaoStore::close_write()
+{
+	assert(file);
+	uint64_t end = END;
+	if (fwrite(&end, sizeof(end), 1, file) != 1 or fclose(file) != 0)
+		throw file_error(filename);
+	file = 0;
+}
+
+void YaoStore::open_read(const string& filename)
+{
+	this->filename = filename;
+	int fd = open(filename.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd < 0 or fstat(fd, &st))
+		throw file_error(filename);
+	map_size = st.st_size;
+	map = (char*) mmap(0, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
+	{
+		map = 0;
+		throw file_error(filename);
+	}
+	madvise(map, map_size, MADV_SEQUENTIAL);
+	pos = released = 0;
+
+	ReceivedMsg header;
+	check(read(header) and header.size() == sizeof(Header));
+	Header expected(VERSION);
+	if (memcmp(header.data(), &expected, sizeof(Header)))
+		throw runtime_error(filename + " was written by an incompatible "
+				"version or with a different garbling scheme");
+	check(map_size >= sizeof(END)
+			and *(uint64_t*) (map + map_size - sizeof(END)) == END);
+}
+
+bool YaoStore::read(ReceivedMsg& buffer)
+{
+	assert(map);
+	uint64_t length;
+	check(pos + sizeof(length) <= map_size);
+	memcpy(&length, map + pos, sizeof(length));
+	if (length == END)
+		return false;
+
+	unsigned char checksum[Hash::hash_length];
+	size_t begin = pos + sizeof(length) + sizeof(checksum);
+	check(begin <= map_size and length <= map_size - begin);
+	auto data = map + begin;
+	Hash hash;
+	hash.update(data, length);
+	hash.final(checksum);
+	check(memcmp(checksum, map + pos + sizeof(length), sizeof(checksum)) == 0);
+
+	buffer.resize(length);
+	memcpy(buffer.data(), data, length);
+	pos = data + length - map;
+	release();
+	return true;
+}
+
+void YaoStore::release()
+{
+	// keep the resident size low for circuits larger than memory
+	size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t end = pos / page_size * page_size;
+	if (end > released)
+	{
+		madvise(map + released, end - released, MADV_DONTNEED);
+		released = end;
+	}
+}
+
+void YaoStore::close_read()
+{
+	if (map)
+		munmap(map, map_size);
+	map = 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * YaoStore.h
+ *
+ */
+
+#ifndef YAO_YAOSTORE_H_
+#define YAO_YAOSTORE_H_
+
+#include "Tools/FlexBuffer.h"
+
+#include <string>
+using namespace std;
+
+/*
+ * Chunked storage of garbled circuits and key material for splitting
+ * Yao's protocol into offline garbling and online evaluation.
+ * Every chunk is protected by a checksum, and the file ends with
+ * a marker in order to detect truncated files.
+ * Reading maps the file into memory and streams it chunk by chunk.
+ */
+class YaoStore
+{
+	static const int VERSION = 1;
+	static const uint64_t END = -1;
+
+	string filename;
+	FILE* file;
+
+	char* map;
+	size_t map_size, pos, released;
+
+	void check(bool condition);
+	void release();
+
+public:
+	enum Phase
+	{
+		NONE,
+		OFFLINE,
+		ONLINE,
+	};
+
+	static string get_filename(const string& dir, const string& role,
+			int thread_num = -1);
+
+	YaoStore();
+	~YaoStore();
+
+	bool is_open() { return file or map; }
+
+	void open_write(const string& filename);
+	void write(const void* data, size_t size);
+	void write(const FlexBuffer& buffer) { write(buffer.data(), buffer.size()); }
+	void close_write();
+
+	void open_read(const string& filename);
+	bool read(ReceivedMsg& buffer);
+	void close_read();
+};
+
+#endif /* YAO_YAOSTORE_H_ */
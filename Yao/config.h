@@ -12,11 +12,14 @@
 
 class YaoFullGate;
 class YaoHalfGate;
+class YaoThreeHalvesGate;
 
-#ifndef FULL_GATES
-typedef YaoHalfGate YaoGate;
-#else
+#if defined(FULL_GATES)
 typedef YaoFullGate YaoGate;
+#elif defined(THREE_HALVES)
+typedef YaoThreeHalvesGate YaoGate;
+#else
+typedef YaoHalfGate YaoGate;
 #endif
 
 #endif /* YAO_CONFIG_H_ */